@@ -0,0 +1,106 @@
+# Shared setup for the benchmark drivers in bench/*/run.sh.
+#
+# Builds the bootstrap compiler of the host variant into $WORK, builds
+# benchmark programs against its runtime, and provides helpers to read the
+# build-stats.json report written by the compiler's -T option and the
+# result lines printed by bench/lib/Bench.Mod.
+#
+# Environment:
+#   VARIANT  bootstrap directory to build (default unix-88 on 64 bit hosts,
+#            unix-44 otherwise)
+#   CC       C compiler (default cc)
+#   CFLAGS   flags for compiling the bootstrap sources (default -O2)
+#   WORK     scratch directory (default $TMPDIR/scream-bench/$VARIANT)
+
+BENCH=$(cd "$(dirname "$0")/.." && pwd)
+ROOT=$(dirname "$BENCH")
+
+if [ -z "$VARIANT" ]; then
+  case $(getconf LONG_BIT 2>/dev/null) in
+    64) VARIANT=unix-88;;
+    *)  VARIANT=unix-44;;
+  esac
+fi
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:--O2}
+WORK=${WORK:-${TMPDIR:-/tmp}/scream-bench/$VARIANT}
+SCREAM=$WORK/scream
+
+die() {
+  echo "$*" >&2
+  exit 2
+}
+
+[ -d "$ROOT/bootstrap/$VARIANT" ] || die "No bootstrap sources for variant $VARIANT."
+case $VARIANT in windows-*) die "The benchmark drivers run on Unix variants only.";; esac
+
+# build_compiler compiles every bootstrap module into $WORK/obj and links
+# the compiler. Nothing is rebuilt while the objects are newer than the
+# sources.
+build_compiler() {
+  mkdir -p "$WORK/obj" || exit 2
+  if [ -x "$SCREAM" ] && [ -z "$(find "$ROOT/bootstrap/SYSTEM.c" "$ROOT/bootstrap/SYSTEM.h" \
+       "$ROOT/bootstrap/$VARIANT" -newer "$SCREAM" 2>/dev/null)" ]; then
+    return 0
+  fi
+  echo "Building the $VARIANT compiler with $CC $CFLAGS." >&2
+  for f in "$ROOT/bootstrap/SYSTEM.c" "$ROOT/bootstrap/$VARIANT"/*.c; do
+    $CC $CFLAGS -w -I"$ROOT/bootstrap" -I"$ROOT/bootstrap/$VARIANT" \
+      -c "$f" -o "$WORK/obj/$(basename "$f" .c).o" || die "Compiling $f failed."
+  done
+  $CC $CFLAGS "$WORK"/obj/*.o -o "$SCREAM" || die "Linking the compiler failed."
+}
+
+# The bootstrap tree has only the C of the runtime, so bench/lib holds
+# interface modules for the parts the programs use. They are translated
+# for their symbol files only; their C is deleted so that the programs
+# include the bootstrap headers and link against the bootstrap objects.
+LIBIFACE="Platform Heap Modules Out Files Strings"
+RUNTIMEOBJ="SYSTEM Configuration Platform Heap Modules Out Strings Files Reals Texts VT100"
+
+# build_lib model: symbol files of bench/lib and the Bench object for size
+# model 2, C or V in $WORK/lib/model.
+build_lib() {
+  lib=$WORK/lib/$1
+  if [ -f "$lib/Bench.o" ] && [ -z "$(find "$BENCH/lib" "$SCREAM" -newer "$lib/Bench.o")" ]; then
+    return 0
+  fi
+  rm -rf "$lib"
+  mkdir -p "$lib" || exit 2
+  cp "$BENCH"/lib/*.Mod "$lib"
+  (cd "$lib" && for i in $LIBIFACE; do echo $i.Mod; done | xargs "$SCREAM" -SsF -O$1 > lib.log 2>&1 \
+   && for i in $LIBIFACE; do rm -f $i.c $i.h; done \
+   && "$SCREAM" -SsF -O$1 Bench.Mod >> lib.log 2>&1) || die "Translating bench/lib failed, see $lib/lib.log."
+  $CC $CFLAGS -w -I"$ROOT/bootstrap" -I"$ROOT/bootstrap/$VARIANT" -c "$lib/Bench.c" -o "$lib/Bench.o" \
+    || die "Compiling $lib/Bench.c failed."
+}
+
+# build_program src dir model [options]: translates src (a main module
+# importing Bench) in dir with the size model and compiler options, and
+# links dir/<module> against the runtime. Fails when either step fails.
+build_program() {
+  mod=$(basename "$1" .Mod)
+  build_lib $3
+  mkdir -p "$2" || exit 2
+  cp "$1" "$2/" && cp "$WORK/lib/$3"/*.sym "$2/" || return 1
+  (cd "$2" && "$SCREAM" -Sm$4 -O$3 $mod.Mod > compile.log 2>&1) || return 1
+  objs=""
+  for o in $RUNTIMEOBJ; do objs="$objs $WORK/obj/$o.o"; done
+  $CC $CFLAGS -w -I"$ROOT/bootstrap" -I"$ROOT/bootstrap/$VARIANT" -I"$WORK/lib/$3" \
+    "$2/$mod.c" "$WORK/lib/$3/Bench.o" $objs -o "$2/$mod" >> "$2/compile.log" 2>&1
+}
+
+# result key: one key=value field of the "bench" lines in ./result.txt.
+result() {
+  sed -n "s/^bench .* $1=\([0-9]*\).*/\1/p" result.txt
+}
+
+# stat key: top level number from ./build-stats.json.
+stat() {
+  sed -n "s/^\"$1\": \([0-9]*\).*/\1/p" build-stats.json
+}
+
+# phase key name: one phase of a top level {"parse": n, ...} object.
+phase() {
+  sed -n "s/^\"$1\": {.*\"$2\": \([0-9]*\).*/\1/p" build-stats.json
+}
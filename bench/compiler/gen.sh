@@ -0,0 +1,194 @@
+#!/bin/sh
+# Writes synthetic Oberon modules that stress one part of the compiler.
+#
+# usage: gen.sh kind size dir
+#
+#   nest     size statements whose expressions nest up to 64 levels deep
+#   procs    size procedures, each calling its predecessor
+#   records  20 record types extending each other, size fields each
+#   case     size CASE statements of 127 labels, singles, lists and ranges
+#   chain    size modules M0..Mn-1, each extending the types of the previous
+#
+# The parser takes at most 128 labels per CASE (OPP.CaseTable), so the case
+# kind scales by the number of statements. Chains longer than 63 modules
+# exceed the compiler's import table.
+#
+# The modules are written into dir. For chain the file list.txt gives the
+# compile order.
+
+[ $# = 3 ] || { echo "usage: gen.sh kind size dir" >&2; exit 2; }
+kind=$1; n=$2; dir=$3
+mkdir -p "$dir" || exit 2
+
+case $kind in
+nest)
+  awk -v n="$n" 'BEGIN {
+    print "MODULE Nest;"
+    print "VAR a, b, c, d: LONGINT; s: SET; r: REAL;"
+    for (p = 0; p * 100 < n; p++) {
+      printf "PROCEDURE P%d*(x, y: LONGINT): LONGINT;\nVAR t: LONGINT;\nBEGIN\n  t := x;\n", p
+      for (i = p * 100; i < n && i < (p + 1) * 100; i++) {
+        d = i % 64 + 1
+        if (i % 3 == 0) {
+          # Left nested: ((((t + x) * y) - a) ...)
+          e = "t"
+          for (k = 0; k < d; k++) {
+            op = substr("+-*+", k % 4 + 1, 1)
+            e = "(" e " " op " " substr("xyab", k % 4 + 1, 1) ")"
+          }
+          printf "  t := %s;\n", e
+        } else if (i % 3 == 1) {
+          # Right nested: x + (y - (a * (b + ...)))
+          e = "t"
+          for (k = 0; k < d; k++) {
+            op = substr("+-*+", k % 4 + 1, 1)
+            e = substr("xyab", k % 4 + 1, 1) " " op " (" e ")"
+          }
+          printf "  t := %s;\n", e
+        } else {
+          # Nested relations and set expressions in a condition.
+          e = "(t > x)"
+          for (k = 0; k < d; k++) {
+            if (k % 3 == 0) e = "(" e " & (y < a + " k "))"
+            else if (k % 3 == 1) e = "(" e " OR ((t MOD " k + 2 ") IN s))"
+            else e = "(~" e " OR (ABS(b) = " k "))"
+          }
+          printf "  IF %s THEN t := t DIV 2 END;\n", e
+        }
+      }
+      printf "  RETURN t\nEND P%d;\n\n", p
+    }
+    print "END Nest."
+  }' > "$dir/Nest.Mod"
+  ;;
+
+procs)
+  awk -v n="$n" 'BEGIN {
+    print "MODULE Procs;"
+    print "VAR total: LONGINT;"
+    for (i = 0; i < n; i++) {
+      printf "\nPROCEDURE P%d%s(x: LONGINT; VAR y: LONGINT): LONGINT;\n", i, (i % 10 == 0) ? "*" : ""
+      print "VAR t, u: LONGINT; a: ARRAY 8 OF LONGINT;"
+      print "BEGIN"
+      printf "  t := x + %d; u := t * 3 - y;\n", i
+      printf "  a[%d] := u; INC(total, a[%d]);\n", i % 8, i % 8
+      if (i > 0) {
+        printf "  IF t > y THEN y := P%d(t DIV 2, u) ELSE y := t END;\n", i - 1
+      } else {
+        print "  IF t > y THEN y := t END;"
+      }
+      print "  RETURN u"
+      printf "END P%d;\n", i
+    }
+    print "\nEND Procs."
+  }' > "$dir/Procs.Mod"
+  ;;
+
+records)
+  awk -v n="$n" 'BEGIN {
+    split("LONGINT|INTEGER|CHAR|REAL|SET|BOOLEAN|Ptr|Name", types, "|")
+    split("%d|%d|CHR(%d MOD 128)|%d.5|{%d MOD 32}|ODD(%d)|NIL|", vals, "|")
+    print "MODULE Records;"
+    print "TYPE"
+    print "  Ptr* = POINTER TO R0;"
+    print "  Name* = ARRAY 4 OF CHAR;"
+    for (r = 0; r < 20; r++) {
+      printf "  R%d* = RECORD%s\n", r, (r > 0) ? " (R" r - 1 ")" : ""
+      for (f = 0; f < n; f++) {
+        printf "    r%df%d*: %s%s\n", r, f, types[f % 8 + 1], (f < n - 1) ? ";" : ""
+      }
+      print "  END;"
+    }
+    print ""
+    for (r = 0; r < 20; r++) {
+      printf "PROCEDURE Fill%d*(VAR x: R%d);\nBEGIN\n", r, r
+      for (f = 0; f < n; f++) {
+        k = f % 8 + 1
+        if (k == 8) {
+          printf "  x.r%df%d := \"abc\";\n", r, f
+        } else if (k == 7) {
+          printf "  x.r%df%d := NIL;\n", r, f
+        } else {
+          printf "  x.r%df%d := " vals[k] ";\n", r, f, f
+        }
+      }
+      if (r > 0) printf "  Fill%d(x)\n", r - 1
+      printf "END Fill%d;\n\n", r
+    }
+    print "END Records."
+  }' > "$dir/Records.Mod"
+  ;;
+
+case)
+  awk -v n="$n" 'BEGIN {
+    print "MODULE Case;"
+    for (p = 0; p * 10 < n; p++) {
+      printf "\nPROCEDURE C%d*(x: LONGINT; ch: CHAR): LONGINT;\nVAR y: LONGINT;\nBEGIN\n  y := 0;\n", p
+      for (c = p * 10; c < n && c < (p + 1) * 10; c++) {
+        if (c % 4 == 3) {
+          # CHAR selector with ranges.
+          print "  CASE ch OF"
+          for (l = 0; l < 64; l++) {
+            printf "  %s %02XX .. %02XX: y := y + %d\n", (l > 0) ? "|" : " ", l * 2, l * 2 + 1, l
+          }
+        } else {
+          print "  CASE x OF"
+          v = c
+          for (l = 0; l < 127; ) {
+            m = l % 3
+            sep = (l > 0) ? "|" : " "
+            if (m == 0) {
+              printf "  %s %d: y := y + %d\n", sep, v, l; v += 2; l++
+            } else if (m == 1) {
+              printf "  %s %d, %d: y := y * %d\n", sep, v, v + 3, l; v += 5; l += 2
+            } else {
+              printf "  %s %d .. %d: y := y - %d\n", sep, v, v + 40, l; v += 50; l++
+            }
+          }
+        }
+        print "  ELSE y := -1"
+        print "  END;"
+      }
+      printf "  RETURN y\nEND C%d;\n", p
+    }
+    print "\nEND Case."
+  }' > "$dir/Case.Mod"
+  ;;
+
+chain)
+  : > "$dir/list.txt"
+  i=0
+  while [ $i -lt "$n" ]; do
+    awk -v i=$i 'BEGIN {
+      printf "MODULE M%d;\n", i
+      if (i > 0) printf "IMPORT P := M%d;\n", i - 1
+      print "TYPE"
+      if (i > 0) {
+        printf "  T* = RECORD (P.T) f%d*: LONGINT; p%d*: P.Ptr END;\n", i, i
+      } else {
+        printf "  T* = RECORD f%d*: LONGINT END;\n", i
+      }
+      print "  Ptr* = POINTER TO T;"
+      print "  Proc* = PROCEDURE (VAR t: T; n: LONGINT): LONGINT;"
+      printf "VAR root*: Ptr; count*: LONGINT;\n"
+      for (k = 0; k < 250; k++) {
+        printf "\nPROCEDURE Q%d*(VAR t: T; n: LONGINT): LONGINT;\nBEGIN\n", k
+        printf "  t.f%d := n + %d;\n", i, k
+        if (i > 0) {
+          printf "  INC(count, P.Q%d(t, n));\n", k
+          printf "  IF t.p%d # NIL THEN t.p%d.f%d := t.f%d END;\n", i, i, i - 1, i
+        }
+        printf "  RETURN t.f%d\nEND Q%d;\n", i, k
+      }
+      printf "\nBEGIN\n  NEW(root); count := Q0(root^, %d)\nEND M%d.\n", i, i
+    }' > "$dir/M$i.Mod"
+    echo "M$i.Mod" >> "$dir/list.txt"
+    i=$((i + 1))
+  done
+  ;;
+
+*)
+  echo "Unknown kind $kind." >&2
+  exit 2
+  ;;
+esac
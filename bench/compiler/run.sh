@@ -0,0 +1,193 @@
+#!/bin/sh
+# Compiler throughput benchmark.
+#
+# usage: run.sh [-u] [case ...]
+#
+# Compiles each case REPEAT times with -T and keeps the fastest time of each
+# phase. Prints the source lines per second of each phase and the peak RSS,
+# then compares them with baseline.txt. A phase more than TOLERANCE percent
+# slower than its baseline, or a peak RSS that much larger, is a regression
+# and makes the script exit with 1.
+#
+#   -u  record the results in baseline.txt instead of comparing them.
+#
+# Cases (default all):
+#   nest procs records case chain   synthetic modules written by gen.sh
+#   self    the compiler's own OPM, OPS, OPT, OPB, OPP, OPC and OPV. Needs
+#           the Oberon sources under SRC (default $ROOT/src, laid out as in
+#           the upstream repository, with the generated Configuration.Mod);
+#           skipped when they are missing.
+#
+# Environment: REPEAT (default 5), TOLERANCE (default 25), MINMS (phases
+# that took fewer milliseconds are not compared, default 50), SRC, and
+# those of ../common.sh.
+
+. "$(dirname "$0")/../common.sh"
+
+update=0
+if [ "$1" = -u ]; then update=1; shift; fi
+cases=${*:-nest procs records case chain self}
+REPEAT=${REPEAT:-5}
+TOLERANCE=${TOLERANCE:-25}
+MINMS=${MINMS:-50}
+SRC=${SRC:-$ROOT/src}
+BASELINE=$BENCH/compiler/baseline.txt
+OUT=$WORK/compiler
+
+RUNTIME="Configuration Platform Heap Reals Modules Strings Out Files Texts VT100"
+FRONTEND="OPM OPS OPT OPB OPP OPC OPV"
+
+# size kind: the generator argument of each synthetic case.
+size() {
+  case $1 in
+    nest) echo 12000;;
+    procs) echo 20000;;
+    records) echo 1000;;
+    case) echo 1500;;
+    chain) echo 60;;
+  esac
+}
+
+# findmod name: the first name.Mod under $SRC. Platform is PlatformUnix.Mod
+# in the upstream layout.
+findmod() {
+  f=$(find "$SRC" -name "$1.Mod" 2>/dev/null | head -n 1)
+  if [ -z "$f" ] && [ "$1" = Platform ]; then
+    f=$(find "$SRC" -name PlatformUnix.Mod 2>/dev/null | head -n 1)
+  fi
+  echo "$f"
+}
+
+# prepare case: fills $OUT/case and sets files to the modules to time.
+prepare() {
+  dir=$OUT/$1
+  rm -rf "$dir"
+  mkdir -p "$dir" || exit 2
+  case $1 in
+    chain)
+      "$BENCH/compiler/gen.sh" chain "$(size chain)" "$dir" || return 1
+      files=$(cat "$dir/list.txt")
+      ;;
+    self)
+      missing=""
+      for m in $RUNTIME $FRONTEND; do
+        f=$(findmod $m)
+        if [ -n "$f" ]; then cp "$f" "$dir/$m.Mod"; else missing="$missing $m.Mod"; fi
+      done
+      if [ -n "$missing" ]; then
+        echo "self: skipped, missing under $SRC:$missing" >&2
+        return 1
+      fi
+      # Symbol files of the runtime; not timed.
+      (cd "$dir" && for m in $RUNTIME; do echo $m.Mod; done | xargs "$SCREAM" -SFs > runtime.log 2>&1) || {
+        echo "self: translating the runtime failed, see $dir/runtime.log" >&2
+        return 1
+      }
+      files=$(for m in $FRONTEND; do printf '%s ' $m.Mod; done)
+      ;;
+    *)
+      "$BENCH/compiler/gen.sh" $1 "$(size $1)" "$dir" || return 1
+      files=$(cd "$dir" && ls *.Mod)
+      ;;
+  esac
+}
+
+# min a b: the smaller number, b when a is empty.
+min() {
+  if [ -z "$1" ] || [ "$2" -lt "$1" ]; then echo $2; else echo $1; fi
+}
+
+# rate ms: lines per second for a phase that took ms milliseconds.
+rate() {
+  if [ "$1" -gt 0 ]; then echo $((lines * 1000 / $1)); else echo 0; fi
+}
+
+# measure case: compiles $files REPEAT times and keeps the shortest time of
+# each phase and the smallest peak RSS.
+measure() {
+  w1=""; w2=""; w3=""; w4=""; total=""; rss=""
+  r=0
+  while [ $r -lt "$REPEAT" ]; do
+    (cd "$dir" && for f in $files; do rm -f "${f%.Mod}.sym" "${f%.Mod}.c" "${f%.Mod}.h"; done
+     rm -f build-stats.json
+     "$SCREAM" -ST $files > compile.log 2>&1) || {
+      echo "$1: compile failed, see $dir/compile.log" >&2
+      return 1
+    }
+    cd "$dir"
+    lines=$(stat lines)
+    w1=$(min "$w1" $(phase phase_wall_ms parse))
+    w2=$(min "$w2" $(phase phase_wall_ms import))
+    w3=$(min "$w3" $(phase phase_wall_ms export))
+    w4=$(min "$w4" $(phase phase_wall_ms codegen))
+    total=$(min "$total" $(stat total_wall_ms))
+    rss=$(min "$rss" $(stat peak_rss_kb))
+    cd "$OUT"
+    r=$((r + 1))
+  done
+}
+
+results=$OUT/results.txt
+mkdir -p "$OUT" || exit 2
+build_compiler
+: > "$results"
+printf '%-8s %7s %10s %10s %10s %10s %8s %8s\n' case lines parse/s import/s export/s codegen/s total_ms rss_kB
+for c in $cases; do
+  case $c in
+    nest|procs|records|case|chain|self) ;;
+    *) die "Unknown case $c.";;
+  esac
+  prepare $c && measure $c || continue
+  set -- $lines $(rate $w1) $(rate $w2) $(rate $w3) $(rate $w4) $w1 $w2 $w3 $w4 $total $rss
+  printf '%-8s %7s %10s %10s %10s %10s %8s %8s\n' $c $1 $2 $3 $4 $5 ${10} ${11}
+  echo "$c $*" >> "$results"
+done
+
+if [ $update = 1 ]; then
+  {
+    echo "# Recorded by run.sh -u on $(uname -sm), $VARIANT, $CC $CFLAGS."
+    echo "# case lines parse import export codegen (lines/s) rss_kB"
+    [ -f "$BASELINE" ] && grep -v '^#' "$BASELINE" | while read c rest; do
+      grep -q "^$c " "$results" || echo "$c $rest"
+    done
+    while read c lines p1 p2 p3 p4 w1 w2 w3 w4 total rss; do
+      echo "$c $lines $p1 $p2 $p3 $p4 $rss"
+    done < "$results"
+  } > "$BASELINE.new" && mv "$BASELINE.new" "$BASELINE"
+  echo "Baseline written to $BASELINE."
+  exit 0
+fi
+
+[ -f "$BASELINE" ] || die "No baseline at $BASELINE; record one with -u."
+regressions=0
+while read c lines p1 p2 p3 p4 w1 w2 w3 w4 total rss; do
+  base=$(grep "^$c " "$BASELINE")
+  if [ -z "$base" ]; then
+    echo "$c: no baseline."
+    continue
+  fi
+  set -- $base
+  if [ "$2" != "$lines" ]; then
+    echo "$c: input has $lines lines, baseline $2; not compared."
+    continue
+  fi
+  i=0
+  for p in parse import export codegen; do
+    i=$((i + 1))
+    eval "cur=\$p$i; ms=\$w$i; ref=\${$((i + 2))}"
+    if [ "$ref" -gt 0 ] && [ "$ms" -ge "$MINMS" ] && [ $((cur * 100)) -lt $((ref * (100 - TOLERANCE))) ]; then
+      echo "$c: $p regressed to $cur lines/s from $ref ($(( (cur - ref) * 100 / ref ))%)."
+      regressions=$((regressions + 1))
+    fi
+  done
+  if [ $((rss * 100)) -gt $(($7 * (100 + TOLERANCE))) ]; then
+    echo "$c: peak RSS grew to $rss kB from $7 kB ($(( (rss - $7) * 100 / $7 ))%)."
+    regressions=$((regressions + 1))
+  fi
+done < "$results"
+
+if [ $regressions -gt 0 ]; then
+  echo "$regressions regressions against $BASELINE."
+  exit 1
+fi
+echo "No regressions against $BASELINE."
@@ -0,0 +1,63 @@
+#!/bin/sh
+# Garbage collector benchmark.
+#
+# usage: run.sh [program ...]
+#
+# Builds the programs of this directory against the bootstrap runtime,
+# runs each REPEAT times and prints its fastest run: allocation throughput,
+# collections, total, maximum, median and 99th percentile pause, and peak
+# RSS. Pause percentiles are upper bounds of the collector's power of two
+# pause histogram.
+#
+# Programs (default all): BinaryTrees ListChurn RecordArrays DeepRecursion
+# FileFinal. Each takes its sizes as arguments; see the module headers.
+#
+# Environment: REPEAT (default 3), ARGS (arguments for every program), and
+# those of ../common.sh.
+
+. "$(dirname "$0")/../common.sh"
+
+programs=${*:-BinaryTrees ListChurn RecordArrays DeepRecursion FileFinal}
+REPEAT=${REPEAT:-3}
+OUT=$WORK/gc
+
+build_compiler
+mkdir -p "$OUT" || exit 2
+printf '%-16s %9s %7s %10s %9s %7s %5s %8s %7s %6s %6s %8s\n' \
+  program ops ms ops/s alloc_MB MB/s gc pause_ms max_us p50_us p99_us rss_kB
+failed=0
+for p in $programs; do
+  [ -f "$BENCH/gc/$p.Mod" ] || die "No program $p in $BENCH/gc."
+  dir=$OUT/$p
+  build_program "$BENCH/gc/$p.Mod" "$dir" 2 || {
+    echo "$p: build failed, see $dir/compile.log" >&2
+    failed=1
+    continue
+  }
+  best=""
+  r=0
+  while [ $r -lt "$REPEAT" ]; do
+    (cd "$dir" && ./$p $ARGS > run.txt 2>&1) || {
+      echo "$p: run failed, see $dir/run.txt" >&2
+      failed=1
+      best=""
+      break
+    }
+    us=$(cd "$dir" && sed -n 's/^bench .* us=\([0-9]*\).*/\1/p' run.txt)
+    if [ -z "$best" ] || [ "$us" -lt "$best" ]; then
+      best=$us
+      cp "$dir/run.txt" "$dir/result.txt"
+    fi
+    r=$((r + 1))
+  done
+  [ -n "$best" ] || continue
+  cd "$dir"
+  ops=$(result ops); us=$(result us); kb=$(result alloc_kb)
+  [ "$us" -gt 0 ] || us=1
+  printf '%-16s %9s %7s %10s %9s %7s %5s %8s %7s %6s %6s %8s\n' $p $ops $((us / 1000)) \
+    $((ops * 1000000 / us)) $((kb / 1024)) $((kb * 1000000 / 1024 / us)) $(result gc) \
+    $(($(result pause_total_us) / 1000)) $(result pause_max_us) $(result pause_p50_us) \
+    $(result pause_p99_us) $(result rss_kb)
+  cd "$OUT"
+done
+exit $failed
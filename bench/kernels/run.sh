@@ -0,0 +1,109 @@
+#!/bin/sh
+# Runtime cost of the generated checks and of the size models.
+#
+# usage: run.sh [kernel ...]
+#
+# Builds every kernel under each combination of the x (index), r (range),
+# t (type guard) and a (assertion) checks, in each size model of MODELS,
+# runs each build REPEAT times and prints one table per kernel: the
+# fastest time of every build and its cost over the build without checks
+# in the same model. A column is a model, a row the enabled checks, so
+# "x-t-" has index checks and type guards only. Every build of a kernel
+# must print the same check value, otherwise the script exits with 1.
+#
+# Kernels (default all): MatMul Words Sort HashTable Records. Each takes
+# its sizes as arguments; see the module headers.
+#
+# Environment: MODELS (default "2 C V"), REPEAT (default 3), ARGS
+# (arguments for every kernel), and those of ../common.sh.
+
+. "$(dirname "$0")/../common.sh"
+
+kernels=${*:-MatMul Words Sort HashTable Records}
+MODELS=${MODELS:-2 C V}
+REPEAT=${REPEAT:-3}
+OUT=$WORK/kernels
+
+COMBOS=""
+for x in x -; do for r in r -; do for t in t -; do for a in a -; do
+  COMBOS="$COMBOS $x$r$t$a"
+done; done; done; done
+
+# options checks: the compiler options that turn the default checks (x, t
+# and a on, r off) into the given ones.
+options() {
+  o=""
+  case $1 in x???) ;; *) o=x;; esac
+  case $1 in ?r??) o=${o}r;; esac
+  case $1 in ??t?) ;; *) o=${o}t;; esac
+  case $1 in ???a) ;; *) o=${o}a;; esac
+  echo $o
+}
+
+build_compiler
+mkdir -p "$OUT" || exit 2
+failed=0
+for k in $kernels; do
+  [ -f "$BENCH/kernels/$k.Mod" ] || die "No kernel $k in $BENCH/kernels."
+  times=$OUT/$k.times
+  : > "$times"
+  for model in $MODELS; do
+    for c in $COMBOS; do
+      dir=$OUT/$k/$model$c
+      rm -rf "$dir"
+      build_program "$BENCH/kernels/$k.Mod" "$dir" $model $(options $c) || {
+        echo "$k -O$model $c: build failed, see $dir/compile.log" >&2
+        failed=1
+        continue
+      }
+      best=""
+      r=0
+      while [ $r -lt "$REPEAT" ]; do
+        (cd "$dir" && ./$k $ARGS > run.txt 2>&1) || {
+          echo "$k -O$model $c: run failed, see $dir/run.txt" >&2
+          failed=1
+          best=""
+          break
+        }
+        us=$(cd "$dir" && sed -n 's/^bench .* us=\([0-9]*\).*/\1/p' run.txt)
+        if [ -z "$best" ] || [ "$us" -lt "$best" ]; then
+          best=$us
+          cp "$dir/run.txt" "$dir/result.txt"
+        fi
+        r=$((r + 1))
+      done
+      [ -n "$best" ] || continue
+      (cd "$dir" && echo "$model $c $(result us) $(result ops) $(result check)") >> "$times"
+    done
+  done
+
+  # One row per check combination, two columns (ms, cost) per model.
+  awk -v kernel=$k -v models="$MODELS" -v combos="$COMBOS" '
+    { us[$1, $2] = $3; ops = $4; check[$1, $2] = $5; if (first == "") first = $5 }
+    END {
+      nm = split(models, m, " "); nc = split(combos, c, " ")
+      printf "\n%s: %d ops, check %s\n%-6s", kernel, ops, first, "checks"
+      for (i = 1; i <= nm; i++) printf " %9s %6s", "O" m[i] " ms", "cost"
+      printf "\n"
+      for (j = 1; j <= nc; j++) {
+        printf "%-6s", c[j]
+        for (i = 1; i <= nm; i++) {
+          if ((m[i], c[j]) in us) {
+            base = us[m[i], "----"]
+            printf " %9.1f", us[m[i], c[j]] / 1000
+            if (base > 0) printf " %+5.0f%%", (us[m[i], c[j]] - base) * 100 / base
+            else printf " %6s", "?"
+          } else printf " %9s %6s", "-", "-"
+        }
+        printf "\n"
+      }
+      bad = 0
+      for (key in check) if (check[key] != first) {
+        split(key, kc, SUBSEP)
+        printf "%s -O%s %s: check %s differs from %s\n", kernel, kc[1], kc[2], check[key], first
+        bad = 1
+      }
+      exit bad
+    }' "$times" || failed=1
+done
+exit $failed
@@ -0,0 +1,40 @@
+#!/bin/sh
+# Correctness tests for the code the optimisations in the compiler and
+# runtime generate.
+#
+# usage: run.sh [test ...]
+#
+# Builds each test program of this directory against the bootstrap
+# runtime and runs it. A test prints what went wrong and halts with a
+# nonzero status when a case fails; the script then exits with 1.
+#
+# Tests (default all): ValueParams RealDigits.
+#
+# Environment: those of ../common.sh.
+
+. "$(dirname "$0")/../common.sh"
+
+tests=${*:-ValueParams RealDigits}
+OUT=$WORK/tests
+
+build_compiler
+mkdir -p "$OUT" || exit 2
+failed=0
+for t in $tests; do
+  [ -f "$BENCH/tests/$t.Mod" ] || die "No test $t in $BENCH/tests."
+  dir=$OUT/$t
+  rm -rf "$dir"
+  build_program "$BENCH/tests/$t.Mod" "$dir" 2 || {
+    echo "$t: build failed, see $dir/compile.log"
+    failed=1
+    continue
+  }
+  if (cd "$dir" && ./$t > run.txt 2>&1); then
+    echo "$t: ok"
+  else
+    echo "$t: FAILED"
+    sed 's/^/  /' "$dir/run.txt"
+    failed=1
+  fi
+done
+exit $failed
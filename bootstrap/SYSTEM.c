@@ -26,35 +26,17 @@
 
 INT64 SYSTEM_DIV(INT64 x, INT64 y)
 {
-  if (x == 0) return 0;
-  if (x >= 0)
-    if (y >= 0) {return x/y;}
-    else        {return -((x-y-1)/(-y));}
-  else
-    if (y >= 0) {return -((y-x-1)/y);}
-    else        {return (-x)/(-y);}
+  return __DIV(x, y);
 }
 
 INT64 SYSTEM_MOD(INT64 x, INT64 y)
 {
-  if (x == 0) return 0;
-  if (x >= 0)
-    if (y >= 0) {return x % y;}
-    else        {return (y+1) + ((x-1) % (-y));}
-  else
-    if (y >= 0) {return (y-1) - ((-x-1) % y);}
-    else        {return -((-x) % (-y));}
+  return __MOD(x, y);
 }
 
 INT64 SYSTEM_ENTIER(double x)
 {
-    INT64 y;
-    if (x >= 0)
-        return (INT64)x;
-    else {
-        y = (INT64)x;
-        if (y <= x) return y; else return y - 1;
-    }
+  return SYSTEM_FLOOR(x);
 }
 
 
@@ -189,18 +189,33 @@ static inline INT64 SYSTEM_ASH(INT64 x, INT64 n) {return __ASH(x,n);}
 #define __MOVE(s, d, n) memcpy((char*)(ADDRESS)(d),(char*)(ADDRESS)(s),n)
 
 
+// Floored DIV and MOD without branches: the truncated C result is
+// corrected when the remainder is nonzero and the signs differ. With a
+// constant divisor the C compiler inlines these and reduces the / and %
+// to a multiply. 0 DIV 0 and 0 MOD 0 are 0, as they always have been:
+// the divisor becomes 1 only when both operands are zero.
+
 extern INT64 SYSTEM_DIV(INT64 x, INT64 y);
-#define __DIVF(x, y) SYSTEM_DIV(x, y)
-#define __DIV(x, y) (((x)>0 && (y)>0) ? (x)/(y) : __DIVF(x, y))
+static inline INT64 SYSTEM_DIVF(INT64 x, INT64 y) {
+  INT64 d = y + ((y == 0) & (x == 0));
+  return x/d - ((x%d != 0) & ((x^y) < 0));
+}
+#define __DIV(x, y) SYSTEM_DIVF(x, y)
+#define __DIVF(x, y) SYSTEM_DIVF(x, y)
 
 
 extern INT64 SYSTEM_MOD(INT64 x, INT64 y);
-#define __MODF(x, y) SYSTEM_MOD(x, y)
-#define __MOD(x, y) (((x)>0 && (y)>0) ? (x)%(y) : __MODF(x, y))
+static inline INT64 SYSTEM_MODF(INT64 x, INT64 y) {
+  INT64 r = x % (y + ((y == 0) & (x == 0)));
+  return r + (y & -((r != 0) & ((r^y) < 0)));
+}
+#define __MOD(x, y) SYSTEM_MODF(x, y)
+#define __MODF(x, y) SYSTEM_MODF(x, y)
 
 
 extern INT64 SYSTEM_ENTIER (double x);
-#define __ENTIER(x) SYSTEM_ENTIER(x)
+static inline INT64 SYSTEM_FLOOR(double x) {INT64 y = (INT64)x; return y - (y > x);}
+#define __ENTIER(x) SYSTEM_FLOOR(x)
 
 
 #define __ABS(x) (((x)<0)?-(x):(x))
@@ -233,7 +248,8 @@ static inline double SYSTEM_ABSD(double i) {return i >= 0.0 ? i : -i;}
 
 
 #define __IS(tag, typ, level) (*(tag-(__BASEOFF-level))==(ADDRESS)typ##__typ)
-#define  __TYPEOF(p)          (*(((ADDRESS**)(p))-1))
+// Region records (Heap_RegionRec) keep their tag's mark bit set, so mask it.
+#define  __TYPEOF(p)          ((ADDRESS*)(*(((ADDRESS*)(p))-1)&~(ADDRESS)1))
 #define __ISP(p, typ, level)  __IS(__TYPEOF(p),typ,level)
 
 
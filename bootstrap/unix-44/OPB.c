@@ -13,8 +13,14 @@
 
 static INT16 OPB_exp;
 static INT64 OPB_maxExp;
+static INT8 OPB_level;
+static OPT_Object OPB_valVar[16];
+static OPT_Node OPB_val[16], OPB_checked[32];
+static INT16 OPB_nofVals, OPB_nofChecked, OPB_nofKnown;
 
 
+static void OPB_Actuals (OPT_Node *a, OPT_Object fp);
+static BOOLEAN OPB_Addressed (OPT_Node n);
 export void OPB_Assign (OPT_Node *x, OPT_Node y);
 static void OPB_BindNodes (INT8 class, OPT_Struct typ, OPT_Node *x, OPT_Node y);
 static INT16 OPB_BoolToInt (BOOLEAN b);
@@ -27,20 +33,28 @@ static void OPB_CheckProc (OPT_Struct x, OPT_Object y);
 static void OPB_CheckPtr (OPT_Node x, OPT_Node y);
 static void OPB_CheckRealType (INT16 f, INT16 nr, OPT_Const x);
 static void OPB_CheckReceiver (OPT_Node *x, OPT_Object fp);
+static void OPB_Checks (OPT_Node n, BOOLEAN cond);
+static void OPB_Clobber (OPT_Node n);
 static void OPB_ConstOp (INT16 op, OPT_Node x, OPT_Node y);
 export void OPB_Construct (INT8 class, OPT_Node *x, OPT_Node y);
 static void OPB_Convert (OPT_Node *x, OPT_Struct typ);
+static BOOLEAN OPB_Covers (OPT_Node f, OPT_Node n);
 export void OPB_DeRef (OPT_Node *x);
+static void OPB_Design (OPT_Node n);
 static void OPB_DynArrParCheck (OPT_Struct ftyp, OPT_Struct atyp, BOOLEAN fvarpar);
 export OPT_Node OPB_EmptySet (void);
 export void OPB_Enter (OPT_Node *procdec, OPT_Node stat, OPT_Object proc);
 export void OPB_Field (OPT_Node *x, OPT_Object y);
+static BOOLEAN OPB_Fixed (OPT_Node d);
+static void OPB_Fold (OPT_Node *x);
 export void OPB_In (OPT_Node *x, OPT_Node y);
 export void OPB_Index (OPT_Node *x, OPT_Node y);
 export void OPB_Inittd (OPT_Node *inittd, OPT_Node *last, OPT_Struct typ);
 static BOOLEAN OPB_IntToBool (INT64 i);
+static void OPB_Kill (OPT_Node x);
 export void OPB_Link (OPT_Node *x, OPT_Node *last, OPT_Node y);
 export void OPB_MOp (INT8 op, OPT_Node *x);
+static BOOLEAN OPB_Mentions (OPT_Node n, OPT_Object v);
 export OPT_Node OPB_NewBoolConst (BOOLEAN boolval);
 export OPT_Node OPB_NewIntConst (INT64 intval);
 export OPT_Node OPB_NewLeaf (OPT_Object obj);
@@ -50,9 +64,17 @@ export OPT_Node OPB_Nil (void);
 static BOOLEAN OPB_NotVar (OPT_Node x);
 export void OPB_Op (INT8 op, OPT_Node *x, OPT_Node y);
 export void OPB_OptIf (OPT_Node *x);
+export void OPB_Optimize (OPT_Node n);
 export void OPB_Param (OPT_Node ap, OPT_Object fp);
 export void OPB_PrepCall (OPT_Node *x, OPT_Object *fpar);
+static void OPB_Propagate (OPT_Node *x);
+static BOOLEAN OPB_Recordable (OPT_Node n);
+static void OPB_Remember (OPT_Object v, OPT_Node x);
+static void OPB_Reset (void);
 export void OPB_Return (OPT_Node *x, OPT_Object proc);
+static OPT_Node OPB_Root (OPT_Node n);
+static BOOLEAN OPB_Same (OPT_Node x, OPT_Node y);
+static void OPB_Sequence (OPT_Node n);
 export void OPB_SetElem (OPT_Node *x);
 static void OPB_SetIntType (OPT_Node node);
 export void OPB_SetRange (OPT_Node *x, OPT_Node y);
@@ -61,8 +83,12 @@ export void OPB_StFct (OPT_Node *par0, INT8 fctno, INT16 parno);
 export void OPB_StPar0 (OPT_Node *par0, INT16 fctno);
 export void OPB_StPar1 (OPT_Node *par0, OPT_Node x, INT8 fctno);
 export void OPB_StParN (OPT_Node *par0, OPT_Node x, INT16 fctno, INT16 n);
+static BOOLEAN OPB_Stable (OPT_Node n);
 export void OPB_StaticLink (INT8 dlev);
+static BOOLEAN OPB_Tracked (OPT_Object obj);
 export void OPB_TypTest (OPT_Node *x, OPT_Object obj, BOOLEAN guard);
+static OPT_Node OPB_Value (OPT_Node x, OPT_Struct typ);
+static void OPB_Walk (OPT_Node n);
 static void OPB_err (INT16 n);
 static INT64 OPB_log (INT64 x);
 
@@ -303,7 +329,7 @@ void OPB_DeRef (OPT_Node *x)
 		btyp = typ->BaseTyp;
 		strobj = typ->strobj;
 		bstrobj = btyp->strobj;
-		if ((((((strobj != NIL && strobj->name[0] != 0x00)) && bstrobj != NIL)) && bstrobj->name[0] != 0x00)) {
+		if ((((((strobj != NIL && (strobj->name->data)[0] != 0x00)) && bstrobj != NIL)) && (bstrobj->name->data)[0] != 0x00)) {
 			btyp->pbused = 1;
 		}
 		OPB_BindNodes(3, btyp, &*x, NIL);
@@ -705,7 +731,7 @@ void OPB_CheckParameters (OPT_Object fp, OPT_Object ap, BOOLEAN checkNames)
 					OPB_err(115);
 				}
 			}
-			if (fp->mode != ap->mode || (checkNames && __STRCMP(fp->name, ap->name) != 0)) {
+			if (fp->mode != ap->mode || (checkNames && __STRCMP(fp->name->data, ap->name->data) != 0)) {
 				OPB_err(115);
 			}
 			ap = ap->link;
@@ -2576,6 +2602,434 @@ void OPB_Inittd (OPT_Node *inittd, OPT_Node *last, OPT_Struct typ)
 	*last = node;
 }
 
+static void OPB_Reset (void)
+{
+	OPB_nofVals = 0;
+	OPB_nofChecked = 0;
+	OPB_nofKnown = 0;
+}
+
+static OPT_Node OPB_Root (OPT_Node n)
+{
+	while ((n != NIL && (__IN(n->class, 0x74, 32) || (n->class == 11 && n->subcl == 29)))) {
+		n = n->left;
+	}
+	return n;
+}
+
+static BOOLEAN OPB_Addressed (OPT_Node n)
+{
+	while (n != NIL) {
+		if ((n->class == 11 && n->subcl == 24)) {
+			return 1;
+		}
+		if (OPB_Addressed(n->left) || OPB_Addressed(n->right)) {
+			return 1;
+		}
+		n = n->link;
+	}
+	return 0;
+}
+
+static BOOLEAN OPB_Tracked (OPT_Object obj)
+{
+	return (((((obj->mode == 1 && obj->mnolev == OPB_level)) && obj->leaf)) && __IN(obj->typ->form, 0x1c, 32));
+}
+
+static BOOLEAN OPB_Stable (OPT_Node n)
+{
+	switch (n->class) {
+		case 0: 
+			return (n->obj->mnolev == OPB_level && n->obj->leaf);
+			break;
+		case 7: 
+			return 1;
+			break;
+		case 2: 
+			return OPB_Stable(n->left);
+			break;
+		case 11: 
+			return (((n->subcl != 24 && n->subcl != 29)) && OPB_Stable(n->left));
+			break;
+		case 4: case 12: 
+			return (OPB_Stable(n->left) && OPB_Stable(n->right));
+			break;
+		default: 
+			return 0;
+			break;
+	}
+	__RETCHK;
+}
+
+static BOOLEAN OPB_Fixed (OPT_Node d)
+{
+	while (d->class == 4) {
+		d = d->left;
+	}
+	return __IN(d->class, 0x03, 32) || (d->class == 3 && OPB_Stable(d->left));
+}
+
+static BOOLEAN OPB_Same (OPT_Node x, OPT_Node y)
+{
+	if (x == NIL || y == NIL) {
+		return x == y;
+	}
+	return (((((((((((x->class == y->class && x->subcl == y->subcl)) && x->typ == y->typ)) && x->obj == y->obj)) && (x->class != 7 || (__IN(x->typ->form, 0x1c, 32) && x->conval->intval == y->conval->intval)))) && OPB_Same(x->left, y->left))) && OPB_Same(x->right, y->right));
+}
+
+static BOOLEAN OPB_Mentions (OPT_Node n, OPT_Object v)
+{
+	return (n != NIL && (((__IN(n->class, 0x03, 32) && n->obj == v) || OPB_Mentions(n->left, v)) || OPB_Mentions(n->right, v)));
+}
+
+static BOOLEAN OPB_Covers (OPT_Node f, OPT_Node n)
+{
+	if (f->class != n->class) {
+		return 0;
+	} else if (n->class == 5) {
+		return (f->typ == n->typ && OPB_Same(f->left, n->left));
+	} else if ((f->left->typ->comp == 2 && n->left->typ->comp == 2)) {
+		return (f->left->typ->n == n->left->typ->n && OPB_Same(f->right, n->right));
+	} else {
+		return (OPB_Same(f->left, n->left) && OPB_Same(f->right, n->right));
+	}
+	__RETCHK;
+}
+
+static BOOLEAN OPB_Recordable (OPT_Node n)
+{
+	if (n->class == 5) {
+		return (((n->left->class == 0 && n->left->typ->form == 11)) && OPB_Stable(n->left)) || (n->left->class == 1 && n->left->typ->comp == 4);
+	} else {
+		return (((n->right->class != 7 && OPB_Stable(n->right))) && (n->left->typ->comp == 2 || OPB_Fixed(n->left)));
+	}
+	__RETCHK;
+}
+
+static void OPB_Kill (OPT_Node x)
+{
+	OPT_Object v = NIL;
+	INT16 i, k;
+	x = OPB_Root(x);
+	if ((x != NIL && __IN(x->class, 0x03, 32))) {
+		v = x->obj;
+		i = 0;
+		k = 0;
+		while (i < OPB_nofVals) {
+			if ((OPB_valVar[__X(i, 16)] != v && OPB_val[__X(i, 16)]->obj != v)) {
+				OPB_valVar[__X(k, 16)] = OPB_valVar[__X(i, 16)];
+				OPB_val[__X(k, 16)] = OPB_val[__X(i, 16)];
+				k += 1;
+			}
+			i += 1;
+		}
+		OPB_nofVals = k;
+		i = 0;
+		k = 0;
+		while (i < OPB_nofChecked) {
+			if (!OPB_Mentions(OPB_checked[__X(i, 32)], v)) {
+				OPB_checked[__X(k, 32)] = OPB_checked[__X(i, 32)];
+				k += 1;
+			}
+			i += 1;
+		}
+		OPB_nofChecked = k;
+	}
+}
+
+static void OPB_Clobber (OPT_Node n)
+{
+	OPT_Node a = NIL;
+	OPT_Object fp = NIL;
+	if (n != NIL) {
+		if (n->class == 13) {
+			OPB_Clobber(n->left);
+			fp = n->obj;
+			a = n->right;
+			while (a != NIL) {
+				if (fp == NIL || fp->mode == 2) {
+					OPB_Kill(a);
+				}
+				OPB_Clobber(a);
+				if (fp != NIL) {
+					fp = fp->link;
+				}
+				a = a->link;
+			}
+		} else {
+			if (n->class == 19) {
+				OPB_Kill(n->left);
+			}
+			OPB_Clobber(n->left);
+			OPB_Clobber(n->right);
+		}
+	}
+}
+
+static OPT_Node OPB_Value (OPT_Node x, OPT_Struct typ)
+{
+	OPT_Node node = NIL;
+	node = OPT_NewNode(x->class);
+	node->typ = typ;
+	node->obj = x->obj;
+	if (x->class == 7) {
+		node->conval = OPT_NewConst();
+		__GUARDEQP(node->conval, OPT_ConstDesc) = *x->conval;
+	}
+	return node;
+}
+
+static void OPB_Remember (OPT_Object v, OPT_Node x)
+{
+	if ((OPB_nofVals < 16 && ((x->class == 7 && x->typ->form == v->typ->form) || (((((x->class == 0 && x->obj != v)) && x->typ == v->typ)) && OPB_Tracked(x->obj))))) {
+		OPB_valVar[__X(OPB_nofVals, 16)] = v;
+		OPB_val[__X(OPB_nofVals, 16)] = OPB_Value(x, v->typ);
+		OPB_nofVals += 1;
+	}
+}
+
+static void OPB_Fold (OPT_Node *x)
+{
+	OPT_Node n = NIL, y = NIL;
+	INT64 a, b, v;
+	n = *x;
+	a = n->left->conval->intval;
+	v = a;
+	if (n->class == 12) {
+		b = n->right->conval->intval;
+		if (((a > 2147483647 || a < -2147483647) || b > 2147483647) || b < -2147483647) {
+			return;
+		}
+		switch (n->subcl) {
+			case 1: 
+				v = a * b;
+				break;
+			case 6: 
+				v = a + b;
+				break;
+			default: 
+				v = a - b;
+				break;
+		}
+	}
+	if (v < OPM_SignedMinimum(n->typ->size) || v > OPM_SignedMaximum(n->typ->size)) {
+		return;
+	}
+	y = OPB_Value(n->left, n->typ);
+	y->conval->intval = v;
+	y->link = n->link;
+	*x = y;
+}
+
+static void OPB_Walk (OPT_Node n)
+{
+	if ((n != NIL && n->class != 0)) {
+		OPB_Propagate(&n);
+	}
+}
+
+static void OPB_Design (OPT_Node n)
+{
+	OPT_Node y = NIL;
+	while (__IN(n->class, 0x7c, 32)) {
+		if (n->class == 4) {
+			y = n->right;
+			OPB_Propagate(&n->right);
+			if (((n->right->class == 7 && y->class != 7)) && ((n->left->typ->comp != 2 || n->right->conval->intval < 0) || n->right->conval->intval >= n->left->typ->n)) {
+				n->right = y;
+			}
+		}
+		n = n->left;
+	}
+}
+
+static void OPB_Actuals (OPT_Node *a, OPT_Object fp)
+{
+	if (*a != NIL) {
+		if ((fp != NIL && fp->mode == 1)) {
+			if (__IN(fp->typ->form, 0x1c, 32)) {
+				OPB_Propagate(&*a);
+			} else {
+				OPB_Walk(*a);
+			}
+			OPB_Actuals(&(*a)->link, fp->link);
+		} else {
+			OPB_Design(*a);
+			if (fp != NIL) {
+				OPB_Actuals(&(*a)->link, fp->link);
+			} else {
+				OPB_Actuals(&(*a)->link, NIL);
+			}
+		}
+	}
+}
+
+static void OPB_Propagate (OPT_Node *x)
+{
+	OPT_Node n = NIL, y = NIL;
+	INT16 i;
+	n = *x;
+	switch (n->class) {
+		case 0: 
+			i = 0;
+			while ((i < OPB_nofVals && OPB_valVar[__X(i, 16)] != n->obj)) {
+				i += 1;
+			}
+			if (i < OPB_nofVals) {
+				y = OPB_Value(OPB_val[__X(i, 16)], n->typ);
+				y->link = n->link;
+				*x = y;
+			}
+			break;
+		case 2: case 3: case 4: case 5: case 6: 
+			OPB_Design(n);
+			break;
+		case 11: 
+			if ((((((n->subcl == 20 && n->typ->form == 4)) && n->left->typ->form == 4)) && n->typ->size >= n->left->typ->size)) {
+				OPB_Propagate(&n->left);
+				if (n->left->class == 7) {
+					OPB_Fold(&*x);
+				}
+			} else if (n->subcl == 7 || n->subcl == 33) {
+				OPB_Propagate(&n->left);
+			} else if ((n->subcl != 24 && n->subcl != 29)) {
+				OPB_Walk(n->left);
+			}
+			break;
+		case 12: 
+			if (__IN(n->subcl, 0x7fe2, 32)) {
+				OPB_Propagate(&n->left);
+				OPB_Propagate(&n->right);
+				if ((((((__IN(n->subcl, 0xc2, 32) && n->typ->form == 4)) && n->left->class == 7)) && n->right->class == 7)) {
+					OPB_Fold(&*x);
+				}
+			} else if (n->subcl != 19) {
+				OPB_Walk(n->left);
+				OPB_Walk(n->right);
+			}
+			break;
+		case 13: 
+			OPB_Actuals(&n->right, n->obj);
+			break;
+		default: 
+			break;
+	}
+}
+
+static void OPB_Checks (OPT_Node n, BOOLEAN cond)
+{
+	OPT_Node a = NIL;
+	INT16 i;
+	if (n != NIL) {
+		if (n->class == 13) {
+			OPB_Checks(n->left, cond);
+			a = n->right;
+			while (a != NIL) {
+				OPB_Checks(a, cond);
+				a = a->link;
+			}
+		} else {
+			OPB_Checks(n->left, cond);
+			OPB_Checks(n->right, cond || (n->class == 12 && __IN(n->subcl, 0x0120, 32)));
+		}
+		if (__IN(n->class, 0x30, 32)) {
+			i = 0;
+			while ((i < OPB_nofKnown && !OPB_Covers(OPB_checked[__X(i, 32)], n))) {
+				i += 1;
+			}
+			if (i < OPB_nofKnown) {
+				n->nocheck = 1;
+			} else if ((((!cond && OPB_nofChecked < 32)) && OPB_Recordable(n))) {
+				OPB_checked[__X(OPB_nofChecked, 32)] = n;
+				OPB_nofChecked += 1;
+			}
+		}
+	}
+}
+
+static void OPB_Sequence (OPT_Node n)
+{
+	OPT_Node branch = NIL;
+	OPB_Reset();
+	while (n != NIL) {
+		switch (n->class) {
+			case 13: case 19: case 26: 
+				if (n->class == 13) {
+					OPB_Actuals(&n->right, n->obj);
+				} else if (n->class == 19) {
+					if (!__IN(n->subcl, 0x82000000, 32)) {
+						OPB_Design(n->left);
+					}
+					if (__IN(n->subcl, 0x6001, 32)) {
+						OPB_Propagate(&n->right);
+					}
+				} else if (n->left != NIL) {
+					OPB_Propagate(&n->left);
+				}
+				OPB_Checks(n, 0);
+				OPB_nofKnown = OPB_nofChecked;
+				OPB_Clobber(n);
+				if ((((((n->class == 19 && n->subcl == 0)) && n->left->class == 0)) && OPB_Tracked(n->left->obj))) {
+					OPB_Remember(n->left->obj, n->right);
+				}
+				OPB_nofKnown = OPB_nofChecked;
+				break;
+			case 20: case 27: 
+				if ((n->class == 20 && n->subcl == 32)) {
+					OPB_Clobber(n);
+				} else {
+					branch = n->left;
+					while (branch != NIL) {
+						OPB_Sequence(branch->right);
+						branch = branch->link;
+					}
+					OPB_Sequence(n->right);
+					OPB_Reset();
+				}
+				break;
+			case 21: 
+				branch = n->right->left;
+				while (branch != NIL) {
+					OPB_Sequence(branch->right);
+					branch = branch->link;
+				}
+				OPB_Sequence(n->right->right);
+				OPB_Reset();
+				break;
+			case 22: 
+				OPB_Sequence(n->right);
+				OPB_Reset();
+				break;
+			case 23: case 24: 
+				OPB_Sequence(n->left);
+				OPB_Reset();
+				break;
+			default: 
+				break;
+		}
+		n = n->link;
+	}
+}
+
+void OPB_Optimize (OPT_Node n)
+{
+	while (n != NIL) {
+		OPB_Optimize(n->left);
+		if ((n->obj != NIL && !OPB_Addressed(n->right))) {
+			OPB_level = n->obj->scope->mnolev;
+			OPB_Sequence(n->right);
+		}
+		n = n->link;
+	}
+}
+
+static void EnumPtrs(void (*P)(void*))
+{
+	__ENUMP(OPB_valVar, 16, P);
+	__ENUMP(OPB_val, 16, P);
+	__ENUMP(OPB_checked, 32, P);
+}
+
 
 export void *OPB__init(void)
 {
@@ -2583,7 +3037,7 @@ export void *OPB__init(void)
 	__MODULE_IMPORT(OPM);
 	__MODULE_IMPORT(OPS);
 	__MODULE_IMPORT(OPT);
-	__REGMOD("OPB", 0);
+	__REGMOD("OPB", EnumPtrs);
 /* BEGIN */
 	OPB_maxExp = OPB_log(4611686018427387904LL);
 	OPB_maxExp = OPB_exp;
@@ -320,7 +320,7 @@ static void OPP_PointerType (OPT_Struct *typ)
 				OPP_err(224);
 			}
 			(*typ)->link = OPT_NewObj();
-			__COPY(OPS_name, (*typ)->link->name, 256);
+			(*typ)->link->name = OPS_ident;
 			(*typ)->BaseTyp = OPT_undftyp;
 			OPS_Get(&OPP_sym);
 		} else {
@@ -555,7 +555,7 @@ static void OPP_selector (OPT_Node *x)
 									if (typ->form == 11) {
 										typ = typ->BaseTyp;
 									}
-									OPT_FindField((*x)->obj->name, typ->BaseTyp, &proc);
+									OPT_FindField((*x)->obj->name->data, typ->BaseTyp, &proc);
 									if (proc != NIL) {
 										(*x)->subcl = 1;
 									} else {
@@ -1008,7 +1008,7 @@ static void Body__17 (void)
 	(*ProcedureDeclaration__16_s->x)->conval = OPT_NewConst();
 	(*ProcedureDeclaration__16_s->x)->conval->intval = c;
 	if (OPP_sym == 38) {
-		if (__STRCMP(OPS_name, (*ProcedureDeclaration__16_s->proc)->name) != 0) {
+		if (__STRCMP(OPS_name, (*ProcedureDeclaration__16_s->proc)->name->data) != 0) {
 			OPP_err(4);
 		}
 		OPS_Get(&OPP_sym);
@@ -1284,9 +1284,6 @@ static void CasePart__31 (OPT_Node *x)
 	if (n > 0) {
 		low = tab[0].low;
 		high = tab[__X(n - 1, 128)].high;
-		if (high - low > 512) {
-			OPP_err(209);
-		}
 	} else {
 		low = 1;
 		high = 0;
@@ -1461,7 +1458,7 @@ static void OPP_StatSeq (OPT_Node *stat)
 				if (y->class != 7) {
 					__MOVE("@@", name, 3);
 					OPT_Insert(name, &t);
-					__MOVE("@for", t->name, 5);
+					t->name = OPS_Intern((CHAR*)"@for", 5);
 					t->mode = 1;
 					t->typ = x->left->typ;
 					obj = OPT_topScope->scope;
@@ -1665,7 +1662,7 @@ static void OPP_Block (OPT_Node *procdec, OPT_Node *statseq)
 				obj->typ = OPT_undftyp;
 				OPP_CheckMark(&obj->vis);
 				if (OPP_sym == 9) {
-					if (((((((((__STRCMP(obj->name, "SHORTINT") == 0 || __STRCMP(obj->name, "INTEGER") == 0) || __STRCMP(obj->name, "LONGINT") == 0) || __STRCMP(obj->name, "HUGEINT") == 0) || __STRCMP(obj->name, "REAL") == 0) || __STRCMP(obj->name, "LONGREAL") == 0) || __STRCMP(obj->name, "SET") == 0) || __STRCMP(obj->name, "CHAR") == 0) || __STRCMP(obj->name, "TRUE") == 0) || __STRCMP(obj->name, "FALSE") == 0) {
+					if (((((((((__STRCMP(obj->name->data, "SHORTINT") == 0 || __STRCMP(obj->name->data, "INTEGER") == 0) || __STRCMP(obj->name->data, "LONGINT") == 0) || __STRCMP(obj->name->data, "HUGEINT") == 0) || __STRCMP(obj->name->data, "REAL") == 0) || __STRCMP(obj->name->data, "LONGREAL") == 0) || __STRCMP(obj->name->data, "SET") == 0) || __STRCMP(obj->name->data, "CHAR") == 0) || __STRCMP(obj->name->data, "TRUE") == 0) || __STRCMP(obj->name->data, "FALSE") == 0) {
 						OPM_Mark(-310, OPM_curpos);
 					}
 					OPS_Get(&OPP_sym);
@@ -1685,9 +1682,9 @@ static void OPP_Block (OPT_Node *procdec, OPT_Node *statseq)
 					while (i < OPP_nofFwdPtr) {
 						typ = OPP_FwdPtr[__X(i, 64)];
 						i += 1;
-						if (__STRCMP(typ->link->name, obj->name) == 0) {
+						if (__STRCMP(typ->link->name->data, obj->name->data) == 0) {
 							typ->BaseTyp = obj->typ;
-							typ->link->name[0] = 0x00;
+							typ->link->name = OPS_Intern((CHAR*)"", 1);
 						}
 					}
 				}
@@ -1745,7 +1742,7 @@ static void OPP_Block (OPT_Node *procdec, OPT_Node *statseq)
 	}
 	i = 0;
 	while (i < OPP_nofFwdPtr) {
-		if (OPP_FwdPtr[__X(i, 64)]->link->name[0] != 0x00) {
+		if ((OPP_FwdPtr[__X(i, 64)]->link->name->data)[0] != 0x00) {
 			OPP_err(128);
 		}
 		OPP_FwdPtr[__X(i, 64)] = NIL;
@@ -43,7 +43,7 @@ typedef
 	struct OPT_NodeDesc {
 		OPT_Node left, right, link;
 		INT8 class, subcl;
-		BOOLEAN readonly;
+		BOOLEAN readonly, nocheck;
 		OPT_Struct typ;
 		OPT_Object obj;
 		OPT_Const conval;
@@ -52,15 +52,17 @@ typedef
 typedef
 	struct OPT_ObjDesc {
 		OPT_Object left, right, link, scope;
-		OPS_Name name;
+		OPS_Ident name;
 		BOOLEAN leaf;
 		INT8 mode, mnolev, vis, history;
-		BOOLEAN used, fpdone;
+		BOOLEAN used, fpdone, nocopy;
 		INT32 fprint;
 		OPT_Struct typ;
 		OPT_Const conval;
 		INT32 adr, linkadr;
 		INT16 x;
+		INT32 hash;
+		OPT_Object hroot, hnext;
 	} OPT_ObjDesc;
 
 typedef
@@ -85,6 +87,7 @@ import OPT_Object OPT_GlbMod[64];
 import OPS_Name OPT_SelfName;
 import BOOLEAN OPT_SYSimported;
 import OPT_Link OPT_Links;
+import INT32 OPT_nofNodes, OPT_nofImported;
 
 import ADDRESS *OPT_ConstDesc__typ;
 import ADDRESS *OPT_ObjDesc__typ;
@@ -121,6 +124,8 @@ import OPT_Struct OPT_SetType (INT32 size);
 import OPT_Struct OPT_ShorterOrLongerType (OPT_Struct x, INT16 dir);
 import INT32 OPT_SizeAlignment (INT32 size);
 import void OPT_TypSize (OPT_Struct typ);
+import void OPT_UseCache (void);
+import void OPT_Warm (CHAR *names, ADDRESS names__len);
 import void *OPT__init(void);
 
 
@@ -26,32 +26,42 @@ export CHAR Platform_NL[3];
 export ADDRESS *Platform_FileIdentity__typ;
 
 export BOOLEAN Platform_Absent (INT16 e);
+export INT16 Platform_Accept (INT32 h, INT32 *c);
 export INT16 Platform_Chdir (CHAR *n, ADDRESS n__len);
 export INT16 Platform_Close (INT32 h);
+export INT16 Platform_Connect (CHAR *n, ADDRESS n__len, INT32 *h);
 export BOOLEAN Platform_ConnectionFailed (INT16 e);
+export INT32 Platform_CpuTime (void);
 export void Platform_Delay (INT32 ms);
 export BOOLEAN Platform_DifferentFilesystems (INT16 e);
 export INT16 Platform_Error (void);
 export void Platform_Exit (INT32 code);
+export INT16 Platform_Fork (INT64 *pid);
 export void Platform_GetClock (INT32 *t, INT32 *d);
 export void Platform_GetEnv (CHAR *var, ADDRESS var__len, CHAR *val, ADDRESS val__len);
 export void Platform_GetTimeOfDay (INT32 *sec, INT32 *usec);
 export INT16 Platform_Identify (INT32 h, Platform_FileIdentity *identity, ADDRESS *identity__typ);
 export INT16 Platform_IdentifyByName (CHAR *n, ADDRESS n__len, Platform_FileIdentity *identity, ADDRESS *identity__typ);
+export void Platform_IgnoreBrokenPipe (void);
 export BOOLEAN Platform_Inaccessible (INT16 e);
 export BOOLEAN Platform_Interrupted (INT16 e);
 export BOOLEAN Platform_IsConsole (INT32 h);
+export INT16 Platform_Listen (CHAR *n, ADDRESS n__len, INT32 *h);
 export void Platform_MTimeAsClock (Platform_FileIdentity i, INT32 *t, INT32 *d);
+export INT16 Platform_MapFile (INT32 h, INT32 l, INT32 *adr);
 export INT16 Platform_MaxNameLength (void);
 export INT16 Platform_MaxPathLength (void);
+export INT32 Platform_MaxRSS (void);
 export INT16 Platform_New (CHAR *n, ADDRESS n__len, INT32 *h);
 export BOOLEAN Platform_NoSuchDirectory (INT16 e);
 export INT32 Platform_OSAllocate (INT32 size);
 export void Platform_OSFree (INT32 address);
 export INT16 Platform_OldRO (CHAR *n, ADDRESS n__len, INT32 *h);
 export INT16 Platform_OldRW (CHAR *n, ADDRESS n__len, INT32 *h);
+export INT16 Platform_Pipe (INT32 *r, INT32 *w);
 export INT16 Platform_Read (INT32 h, INT32 p, INT32 l, INT32 *n);
 export INT16 Platform_ReadBuf (INT32 h, SYSTEM_BYTE *b, ADDRESS b__len, INT32 *n);
+export INT16 Platform_Redirect (INT32 h, INT32 to);
 export INT16 Platform_Rename (CHAR *o, ADDRESS o__len, CHAR *n, ADDRESS n__len);
 export BOOLEAN Platform_SameFile (Platform_FileIdentity i1, Platform_FileIdentity i2);
 export BOOLEAN Platform_SameFileTime (Platform_FileIdentity i1, Platform_FileIdentity i2);
@@ -61,6 +71,8 @@ export void Platform_SetInterruptHandler (Platform_SignalHandler handler);
 export void Platform_SetMTime (Platform_FileIdentity *target, ADDRESS *target__typ, Platform_FileIdentity source);
 export void Platform_SetQuitHandler (Platform_SignalHandler handler);
 export INT16 Platform_Size (INT32 h, INT32 *l);
+static BOOLEAN Platform_SocketName (CHAR *n, ADDRESS n__len);
+export INT16 Platform_Spawn (CHAR *cmd, ADDRESS cmd__len, INT64 *pid);
 export INT16 Platform_Sync (INT32 h);
 export INT16 Platform_System (CHAR *cmd, ADDRESS cmd__len);
 static void Platform_TestLittleEndian (void);
@@ -69,6 +81,8 @@ export BOOLEAN Platform_TimedOut (INT16 e);
 export BOOLEAN Platform_TooManyFiles (INT16 e);
 export INT16 Platform_Truncate (INT32 h, INT32 l);
 export INT16 Platform_Unlink (CHAR *n, ADDRESS n__len);
+export INT16 Platform_UnmapFile (INT32 adr, INT32 l);
+export INT16 Platform_Wait (INT64 pid, INT16 *status);
 export INT16 Platform_Write (INT32 h, INT32 p, INT32 l);
 static void Platform_YMDHMStoClock (INT32 ye, INT32 mo, INT32 da, INT32 ho, INT32 mi, INT32 se, INT32 *t, INT32 *d);
 export BOOLEAN Platform_getEnv (CHAR *var, ADDRESS var__len, CHAR *val, ADDRESS val__len);
@@ -84,6 +98,16 @@ export BOOLEAN Platform_getEnv (CHAR *var, ADDRESS var__len, CHAR *val, ADDRESS
 #include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <signal.h>
+#include <string.h>
+extern char **environ;
+#define Platform_E2BIG()	E2BIG
 #define Platform_EACCES()	EACCES
 #define Platform_EAGAIN()	EAGAIN
 #define Platform_ECONNABORTED()	ECONNABORTED
@@ -99,11 +123,19 @@ export BOOLEAN Platform_getEnv (CHAR *var, ADDRESS var__len, CHAR *val, ADDRESS
 #define Platform_EXDEV()	EXDEV
 #define Platform_NAMEMAX()	NAME_MAX
 #define Platform_PATHMAX()	PATH_MAX
+#define Platform_acceptsocket(fd)	(INTEGER)accept(fd, 0, 0)
 #define Platform_allocate(size)	(ADDRESS)((void*)malloc((size_t)size))
+#define Platform_argvector()	char *argv[256]; pid_t child
+#define Platform_bindsocket(fd)	bind(fd, (struct sockaddr*)&sa, sizeof sa)
 #define Platform_chdir(n, n__len)	chdir((char*)n)
+#define Platform_clock()	(LONGINT)(clock() / (CLOCKS_PER_SEC / 1000))
+#define Platform_cloexec(fd)	fcntl(fd, F_SETFD, FD_CLOEXEC)
 #define Platform_closefile(fd)	close(fd)
+#define Platform_connectsocket(fd)	connect(fd, (struct sockaddr*)&sa, sizeof sa)
+#define Platform_dup2(fd, to)	dup2(fd, to)
 #define Platform_err()	errno
 #define Platform_exit(code)	exit((int)code)
+#define Platform_fork()	(INT64)fork()
 #define Platform_free(address)	free((void*)address)
 #define Platform_fstat(fd)	fstat(fd, &s)
 #define Platform_fsync(fd)	fsync(fd)
@@ -111,26 +143,44 @@ export BOOLEAN Platform_getEnv (CHAR *var, ADDRESS var__len, CHAR *val, ADDRESS
 #define Platform_getcwd(cwd, cwd__len)	getcwd((char*)cwd, cwd__len)
 #define Platform_getenv(var, var__len)	getenv((char*)var)
 #define Platform_getpid()	(INTEGER)getpid()
+#define Platform_getrusage()	struct rusage ru; getrusage(RUSAGE_SELF, &ru)
 #define Platform_gettimeval()	struct timeval tv; gettimeofday(&tv,0)
+#define Platform_ignoresigpipe()	signal(SIGPIPE, SIG_IGN)
 #define Platform_isatty(fd)	isatty(fd)
+#define Platform_listensocket(fd)	listen(fd, 16)
 #define Platform_lseek(fd, o, w)	lseek(fd, o, w)
+#define Platform_mapfailed()	(ADDRESS)MAP_FAILED
+#define Platform_mmapro(fd, l)	(ADDRESS)mmap(0, (size_t)l, PROT_READ, MAP_PRIVATE, fd, 0)
+#define Platform_munmap(a, l)	munmap((void*)(ADDRESS)a, (size_t)l)
 #define Platform_nanosleep(s, ns)	struct timespec req, rem; req.tv_sec = s; req.tv_nsec = ns; nanosleep(&req, &rem)
+#define Platform_nullarg(n)	argv[n] = 0
 #define Platform_opennew(n, n__len)	open((char*)n, O_CREAT | O_TRUNC | O_RDWR, 0664)
 #define Platform_openro(n, n__len)	open((char*)n, O_RDONLY)
 #define Platform_openrw(n, n__len)	open((char*)n, O_RDWR)
+#define Platform_pipe()	int pfd[2]; int pres = pipe(pfd)
+#define Platform_pipefailed()	(pres < 0)
+#define Platform_piperead()	(LONGINT)pfd[0]
+#define Platform_pipewrite()	(LONGINT)pfd[1]
+#define Platform_posixspawn()	(INTEGER)posix_spawnp(&child, argv[0], 0, 0, argv, environ)
 #define Platform_readfile(fd, p, l)	(LONGINT)read(fd, (void*)(ADDRESS)(p), l)
 #define Platform_rename(o, o__len, n, n__len)	rename((char*)o, (char*)n)
+#define Platform_rumaxrss()	(LONGINT)ru.ru_maxrss
 #define Platform_sectotm(s)	struct tm *time = localtime((time_t*)&s)
 #define Platform_seekcur()	SEEK_CUR
 #define Platform_seekend()	SEEK_END
 #define Platform_seekset()	SEEK_SET
+#define Platform_setarg(n, s, o)	argv[n] = (char*)&s[o]
 #define Platform_sethandler(s, h)	SystemSetHandler(s, (ADDRESS)h)
+#define Platform_sockaddr(n, n__len)	struct sockaddr_un sa; memset(&sa, 0, sizeof sa); sa.sun_family = AF_UNIX; strncpy(sa.sun_path, (char*)n, sizeof sa.sun_path - 1)
+#define Platform_spawnedpid()	(INT64)child
 #define Platform_stat(n, n__len)	stat((char*)n, &s)
 #define Platform_statdev()	(LONGINT)s.st_dev
 #define Platform_statino()	(LONGINT)s.st_ino
 #define Platform_statmtime()	(LONGINT)s.st_mtime
 #define Platform_statsize()	(ADDRESS)s.st_size
+#define Platform_statusword()	(INTEGER)wstatus
 #define Platform_structstats()	struct stat s
+#define Platform_sunpathlen()	(INTEGER)sizeof(((struct sockaddr_un*)0)->sun_path)
 #define Platform_system(str, str__len)	system((char*)str)
 #define Platform_tmhour()	(LONGINT)time->tm_hour
 #define Platform_tmmday()	(LONGINT)time->tm_mday
@@ -140,7 +190,10 @@ export BOOLEAN Platform_getEnv (CHAR *var, ADDRESS var__len, CHAR *val, ADDRESS
 #define Platform_tmyear()	(LONGINT)time->tm_year
 #define Platform_tvsec()	tv.tv_sec
 #define Platform_tvusec()	tv.tv_usec
+#define Platform_unixsocket()	(INTEGER)socket(AF_UNIX, SOCK_STREAM, 0)
 #define Platform_unlink(n, n__len)	unlink((char*)n)
+#define Platform_waitpid(pid)	(INTEGER)waitpid((pid_t)pid, &wstatus, 0)
+#define Platform_waitstatus()	int wstatus
 #define Platform_writefile(fd, p, l)	write(fd, (void*)(ADDRESS)(p), l)
 
 BOOLEAN Platform_TooManyFiles (INT16 e)
@@ -270,6 +323,17 @@ INT32 Platform_Time (void)
 	return (int)__MOD(ms - Platform_TimeStart, 2147483647);
 }
 
+INT32 Platform_CpuTime (void)
+{
+	return Platform_clock();
+}
+
+INT32 Platform_MaxRSS (void)
+{
+	Platform_getrusage();
+	return Platform_rumaxrss();
+}
+
 void Platform_Delay (INT32 ms)
 {
 	INT32 s, ns;
@@ -285,6 +349,169 @@ INT16 Platform_System (CHAR *cmd, ADDRESS cmd__len)
 	return Platform_system(cmd, cmd__len);
 }
 
+INT16 Platform_Spawn (CHAR *cmd, ADDRESS cmd__len, INT64 *pid)
+{
+	INT16 argc, res;
+	INT32 i, j;
+	BOOLEAN quoted;
+	__DUP(cmd, cmd__len, CHAR);
+	Platform_argvector();
+	argc = 0;
+	i = 0;
+	j = 0;
+	while (cmd[__X(i, cmd__len)] != 0x00) {
+		while (cmd[__X(i, cmd__len)] == ' ') {
+			i += 1;
+		}
+		if (cmd[__X(i, cmd__len)] != 0x00) {
+			if (argc >= 255) {
+				__DEL(cmd);
+				return Platform_E2BIG();
+			}
+			Platform_setarg(argc, cmd, j);
+			argc += 1;
+			quoted = 0;
+			while ((cmd[__X(i, cmd__len)] != 0x00 && (quoted || cmd[__X(i, cmd__len)] != ' '))) {
+				if (cmd[__X(i, cmd__len)] == '"') {
+					quoted = !quoted;
+				} else {
+					cmd[__X(j, cmd__len)] = cmd[__X(i, cmd__len)];
+					j += 1;
+				}
+				i += 1;
+			}
+			if (cmd[__X(i, cmd__len)] != 0x00) {
+				i += 1;
+			}
+			cmd[__X(j, cmd__len)] = 0x00;
+			j += 1;
+		}
+	}
+	if (argc == 0) {
+		__DEL(cmd);
+		return Platform_ENOENT();
+	}
+	Platform_nullarg(argc);
+	res = Platform_posixspawn();
+	if (res == 0) {
+		*pid = Platform_spawnedpid();
+	}
+	__DEL(cmd);
+	return res;
+}
+
+INT16 Platform_Wait (INT64 pid, INT16 *status)
+{
+	Platform_waitstatus();
+	while (Platform_waitpid(pid) < 0) {
+		if (Platform_err() != Platform_EINTR()) {
+			return Platform_err();
+		}
+	}
+	*status = Platform_statusword();
+	return 0;
+}
+
+INT16 Platform_Fork (INT64 *pid)
+{
+	*pid = Platform_fork();
+	if (*pid < 0) {
+		*pid = 0;
+		return Platform_err();
+	}
+	return 0;
+}
+
+INT16 Platform_Pipe (INT32 *r, INT32 *w)
+{
+	Platform_pipe();
+	if (Platform_pipefailed()) {
+		return Platform_err();
+	}
+	*r = Platform_piperead();
+	*w = Platform_pipewrite();
+	Platform_cloexec(*r);
+	Platform_cloexec(*w);
+	return 0;
+}
+
+INT16 Platform_Redirect (INT32 h, INT32 to)
+{
+	if (Platform_dup2(h, to) < 0) {
+		return Platform_err();
+	}
+	return 0;
+}
+
+void Platform_IgnoreBrokenPipe (void)
+{
+	Platform_ignoresigpipe();
+}
+
+static BOOLEAN Platform_SocketName (CHAR *n, ADDRESS n__len)
+{
+	INT16 i;
+	i = 0;
+	while ((i < n__len && n[__X(i, n__len)] != 0x00)) {
+		i += 1;
+	}
+	return (i > 0 && i < Platform_sunpathlen());
+}
+
+INT16 Platform_Listen (CHAR *n, ADDRESS n__len, INT32 *h)
+{
+	INT16 fd, r;
+	if (!Platform_SocketName((void*)n, n__len)) {
+		return Platform_ENOENT();
+	}
+	Platform_sockaddr(n, n__len);
+	fd = Platform_unixsocket();
+	if (fd < 0) {
+		return Platform_err();
+	}
+	Platform_unlink(n, n__len);
+	if (Platform_bindsocket(fd) < 0 || Platform_listensocket(fd) < 0) {
+		r = Platform_err();
+		Platform_closefile(fd);
+		return r;
+	}
+	Platform_cloexec(fd);
+	*h = fd;
+	return 0;
+}
+
+INT16 Platform_Accept (INT32 h, INT32 *c)
+{
+	INT16 fd;
+	fd = Platform_acceptsocket(h);
+	if (fd < 0) {
+		return Platform_err();
+	}
+	Platform_cloexec(fd);
+	*c = fd;
+	return 0;
+}
+
+INT16 Platform_Connect (CHAR *n, ADDRESS n__len, INT32 *h)
+{
+	INT16 fd, r;
+	if (!Platform_SocketName((void*)n, n__len)) {
+		return Platform_ENOENT();
+	}
+	Platform_sockaddr(n, n__len);
+	fd = Platform_unixsocket();
+	if (fd < 0) {
+		return Platform_err();
+	}
+	if (Platform_connectsocket(fd) < 0) {
+		r = Platform_err();
+		Platform_closefile(fd);
+		return r;
+	}
+	*h = fd;
+	return 0;
+}
+
 INT16 Platform_Error (void)
 {
 	return Platform_err();
@@ -402,6 +629,24 @@ INT16 Platform_Size (INT32 h, INT32 *l)
 	return 0;
 }
 
+INT16 Platform_MapFile (INT32 h, INT32 l, INT32 *adr)
+{
+	*adr = Platform_mmapro(h, l);
+	if (*adr == Platform_mapfailed()) {
+		*adr = 0;
+		return Platform_err();
+	}
+	return 0;
+}
+
+INT16 Platform_UnmapFile (INT32 adr, INT32 l)
+{
+	if (Platform_munmap(adr, l) < 0) {
+		return Platform_err();
+	}
+	return 0;
+}
+
 INT16 Platform_Read (INT32 h, INT32 p, INT32 l, INT32 *n)
 {
 	*n = Platform_readfile(h, p, l);
@@ -8,6 +8,10 @@
 #include "SYSTEM.h"
 
 
+static REAL Reals_ten[11];
+static LONGREAL Reals_tenL[23];
+static INT64 Reals_cacheF[87];
+static INT16 Reals_cacheE[87];
 
 
 static void Reals_BytesToHex (SYSTEM_BYTE *b, ADDRESS b__len, SYSTEM_BYTE *d, ADDRESS d__len);
@@ -15,12 +19,29 @@ export void Reals_Convert (REAL x, INT16 n, CHAR *d, ADDRESS d__len);
 export void Reals_ConvertH (REAL y, CHAR *d, ADDRESS d__len);
 export void Reals_ConvertHL (LONGREAL x, CHAR *d, ADDRESS d__len);
 export void Reals_ConvertL (LONGREAL x, INT16 n, CHAR *d, ADDRESS d__len);
+export REAL Reals_Decimal (CHAR *d, ADDRESS d__len, INT16 n, INT32 e);
+export LONGREAL Reals_DecimalL (CHAR *d, ADDRESS d__len, INT16 n, INT32 e);
+static void Reals_DecimalText (CHAR *d, ADDRESS d__len, INT16 i, INT16 n, INT32 e, CHAR *s, ADDRESS s__len);
+export INT16 Reals_Digits (REAL x, INT16 p, CHAR *d, ADDRESS d__len, INT16 *e);
+export INT16 Reals_DigitsL (LONGREAL x, INT16 p, CHAR *d, ADDRESS d__len, INT16 *e);
 export INT16 Reals_Expo (REAL x);
 export INT16 Reals_ExpoL (LONGREAL x);
+static BOOLEAN Reals_Grisu (INT64 f, INT16 e, BOOLEAN closer, CHAR *d, ADDRESS d__len, INT16 *n, INT16 *x);
+static void Reals_InitPowers (void);
+static BOOLEAN Reals_RoundWeed (CHAR *d, ADDRESS d__len, INT16 n, INT64 dist, INT64 unsafe, INT64 rest, INT64 tenk, INT64 unit);
+static INT16 Reals_ScanE (CHAR *s, ADDRESS s__len, CHAR *d, ADDRESS d__len, INT16 *e);
 export void Reals_SetExpo (REAL *x, INT16 ex);
 export REAL Reals_Ten (INT16 e);
 export LONGREAL Reals_TenL (INT16 e);
+static INT64 Reals_Times (INT64 x, INT64 y);
 static CHAR Reals_ToHex (INT16 i);
+static INT16 Reals_Trim (CHAR *d, ADDRESS d__len, INT16 n);
+
+#include <stdlib.h>
+#define Reals_strtod(s, s__len)	strtod((char*)s, NULL)
+#define Reals_strtof(s, s__len)	strtof((char*)s, NULL)
+#include <stdio.h>
+#define Reals_formatE(x, k, s, s__len)	snprintf((char*)s, s__len, "%.*e", (int)k, x)
 
 
 REAL Reals_Ten (INT16 e)
@@ -112,6 +133,366 @@ void Reals_Convert (REAL x, INT16 n, CHAR *d, ADDRESS d__len)
 	Reals_ConvertL(x, n, (void*)d, d__len);
 }
 
+static void Reals_DecimalText (CHAR *d, ADDRESS d__len, INT16 i, INT16 n, INT32 e, CHAR *s, ADDRESS s__len)
+{
+	INT16 k, j;
+	CHAR x[12];
+	BOOLEAN sticky;
+	sticky = 0;
+	if (n - i > 64) {
+		k = i + 64;
+		while ((k < n && d[__X(k, d__len)] == '0')) {
+			k += 1;
+		}
+		sticky = k < n;
+		e += (n - i) - 64;
+		n = i + 64;
+	}
+	k = 0;
+	while (i < n) {
+		s[__X(k, s__len)] = d[__X(i, d__len)];
+		k += 1;
+		i += 1;
+	}
+	if (sticky) {
+		s[__X(k, s__len)] = '1';
+		k += 1;
+		e -= 1;
+	}
+	s[__X(k, s__len)] = 'E';
+	k += 1;
+	if (e < 0) {
+		s[__X(k, s__len)] = '-';
+		k += 1;
+		e = -e;
+	}
+	j = 0;
+	do {
+		x[__X(j, 12)] = __CHR((int)__MOD(e, 10) + 48);
+		e = __DIV(e, 10);
+		j += 1;
+	} while (!(e == 0));
+	while (j > 0) {
+		j -= 1;
+		s[__X(k, s__len)] = x[__X(j, 12)];
+		k += 1;
+	}
+	s[__X(k, s__len)] = 0x00;
+}
+
+LONGREAL Reals_DecimalL (CHAR *d, ADDRESS d__len, INT16 n, INT32 e)
+{
+	INT16 i, k;
+	INT64 w;
+	CHAR s[80];
+	i = 0;
+	while ((i < n && d[__X(i, d__len)] == '0')) {
+		i += 1;
+	}
+	while ((n > i && d[__X(n - 1, d__len)] == '0')) {
+		n -= 1;
+		e += 1;
+	}
+	if (i == n) {
+		return (LONGREAL)0;
+	}
+	if (n - i <= 18) {
+		w = 0;
+		k = i;
+		while (k < n) {
+			w = w * 10 + (INT64)((INT16)d[__X(k, d__len)] - 48);
+			k += 1;
+		}
+		if (w <= 9007199254740992LL) {
+			if ((0 <= e && e <= 22)) {
+				return w * Reals_tenL[__X(e, 23)];
+			} else if ((-22 <= e && e < 0)) {
+				return w / (LONGREAL)Reals_tenL[__X(-e, 23)];
+			}
+		}
+	}
+	Reals_DecimalText((void*)d, d__len, i, n, e, (void*)s, 80);
+	return Reals_strtod(s, 80);
+}
+
+REAL Reals_Decimal (CHAR *d, ADDRESS d__len, INT16 n, INT32 e)
+{
+	INT16 i, k;
+	INT32 w;
+	CHAR s[80];
+	i = 0;
+	while ((i < n && d[__X(i, d__len)] == '0')) {
+		i += 1;
+	}
+	while ((n > i && d[__X(n - 1, d__len)] == '0')) {
+		n -= 1;
+		e += 1;
+	}
+	if (i == n) {
+		return (REAL)0;
+	}
+	if (n - i <= 7) {
+		w = 0;
+		k = i;
+		while (k < n) {
+			w = w * 10 + ((INT16)d[__X(k, d__len)] - 48);
+			k += 1;
+		}
+		if ((0 <= e && e <= 10)) {
+			return (REAL)w * Reals_ten[__X(e, 11)];
+		} else if ((-10 <= e && e < 0)) {
+			return (REAL)w / (REAL)Reals_ten[__X(-e, 11)];
+		}
+	}
+	Reals_DecimalText((void*)d, d__len, i, n, e, (void*)s, 80);
+	return Reals_strtof(s, 80);
+}
+
+static INT16 Reals_Trim (CHAR *d, ADDRESS d__len, INT16 n)
+{
+	while ((n > 1 && d[__X(n - 1, d__len)] == '0')) {
+		n -= 1;
+	}
+	return n;
+}
+
+static INT16 Reals_ScanE (CHAR *s, ADDRESS s__len, CHAR *d, ADDRESS d__len, INT16 *e)
+{
+	INT16 i, n;
+	BOOLEAN neg;
+	d[0] = s[0];
+	n = 1;
+	i = 1;
+	if (s[__X(1, s__len)] == '.') {
+		i = 2;
+		while (s[__X(i, s__len)] != 'e') {
+			d[__X(n, d__len)] = s[__X(i, s__len)];
+			n += 1;
+			i += 1;
+		}
+	}
+	i += 1;
+	neg = s[__X(i, s__len)] == '-';
+	i += 1;
+	*e = 0;
+	while (s[__X(i, s__len)] != 0x00) {
+		*e = (*e * 10 + (INT16)s[__X(i, s__len)]) - 48;
+		i += 1;
+	}
+	if (neg) {
+		*e = -*e;
+	}
+	return n;
+}
+
+static INT64 Reals_Times (INT64 x, INT64 y)
+{
+	INT64 a, b, c, d;
+	a = __ASHR(x, 31);
+	b = __MASK(x, -2147483648LL);
+	c = __ASHR(y, 31);
+	d = __MASK(y, -2147483648LL);
+	return a * c + __ASHR(((a * d + b * c) + __ASHR(b * d, 31)) + 1073741824, 31);
+}
+
+static BOOLEAN Reals_RoundWeed (CHAR *d, ADDRESS d__len, INT16 n, INT64 dist, INT64 unsafe, INT64 rest, INT64 tenk, INT64 unit)
+{
+	INT64 small, big;
+	small = dist - unit;
+	big = dist + unit;
+	while ((((rest < small && unsafe - rest >= tenk)) && (rest + tenk < small || small - rest >= (rest + tenk) - small))) {
+		d[__X(n - 1, d__len)] = __CHR((INT16)d[__X(n - 1, d__len)] - 1);
+		rest += tenk;
+	}
+	if ((((rest < big && unsafe - rest >= tenk)) && (rest + tenk < big || big - rest > (rest + tenk) - big))) {
+		return 0;
+	}
+	return (2 * unit <= rest && rest <= unsafe - 4 * unit);
+}
+
+static BOOLEAN Reals_Grisu (INT64 f, INT16 e, BOOLEAN closer, CHAR *d, ADDRESS d__len, INT16 *n, INT16 *x)
+{
+	INT64 wf, hf, lf, cf, one, unit, unsafe, fractionals, rest;
+	INT32 integrals, divisor, digit;
+	INT16 s, i, q, kappa;
+	wf = f;
+	s = 0;
+	while (wf < 9007199254740992LL) {
+		wf = __ASHL(wf, 8);
+		s += 8;
+	}
+	while (wf < 2305843009213693952LL) {
+		wf = __ASHL(wf, 1);
+		s += 1;
+	}
+	hf = __ASHL(2 * f + 1, s - 1);
+	if (closer) {
+		lf = __ASHL(4 * f - 1, s - 2);
+	} else {
+		lf = __ASHL(2 * f - 1, s - 1);
+	}
+	e -= s;
+	i = __DIV(-__ASHR((e + 60) * 78913, 18) + 355, 8);
+	while (Reals_cacheE[__X(i, 87)] < -121 - e) {
+		i += 1;
+	}
+	cf = Reals_cacheF[__X(i, 87)];
+	q = -((e + Reals_cacheE[__X(i, 87)]) + 62);
+	wf = Reals_Times(wf, cf);
+	hf = Reals_Times(hf, cf) + 1;
+	lf = Reals_Times(lf, cf) - 1;
+	unit = 1;
+	unsafe = hf - lf;
+	one = __ASHL(1, q);
+	integrals = (INT32)__ASHR(hf, q);
+	fractionals = hf - __ASHL(integrals, q);
+	kappa = 0;
+	divisor = 1;
+	if (integrals > 0) {
+		kappa = 1;
+		while (divisor <= __DIV(integrals, 10)) {
+			divisor = divisor * 10;
+			kappa += 1;
+		}
+	}
+	*n = 0;
+	while (kappa > 0) {
+		digit = __DIV(integrals, divisor);
+		d[__X(*n, d__len)] = __CHR(digit + 48);
+		*n += 1;
+		integrals -= digit * divisor;
+		kappa -= 1;
+		rest = __ASHL(integrals, q) + fractionals;
+		if (rest < unsafe) {
+			*x = (((kappa + 348) - 8 * i) + *n) - 1;
+			return Reals_RoundWeed((void*)d, d__len, *n, hf - wf, unsafe, rest, __ASHL(divisor, q), unit);
+		}
+		divisor = __DIV(divisor, 10);
+	}
+	for (;;) {
+		if (*n == d__len) {
+			return 0;
+		}
+		fractionals = fractionals * 10;
+		unit = unit * 10;
+		unsafe = unsafe * 10;
+		digit = (INT32)__ASHR(fractionals, q);
+		d[__X(*n, d__len)] = __CHR(digit + 48);
+		*n += 1;
+		fractionals -= __ASHL(digit, q);
+		kappa -= 1;
+		if (fractionals < unsafe) {
+			*x = (((kappa + 348) - 8 * i) + *n) - 1;
+			return Reals_RoundWeed((void*)d, d__len, *n, (hf - wf) * unit, unsafe, fractionals, one, unit);
+		}
+	}
+	__RETCHK;
+}
+
+INT16 Reals_DigitsL (LONGREAL x, INT16 p, CHAR *d, ADDRESS d__len, INT16 *e)
+{
+	INT64 f;
+	INT16 be, k, n;
+	CHAR g[20];
+	CHAR s[32];
+	if (x < (LONGREAL)0) {
+		x = -x;
+	}
+	if ((p <= 0 || p > 17)) {
+		p = 17;
+	}
+	if (x == (LONGREAL)0) {
+		d[0] = '0';
+		*e = 0;
+		return 1;
+	}
+	f = __MASK((__VAL(INT64, x)), -4503599627370496LL);
+	be = (INT16)__ASHR((__VAL(INT64, x)), 52);
+	if (be == 0) {
+		k = -1074;
+	} else {
+		f += 4503599627370496LL;
+		k = be - 1075;
+	}
+	if (Reals_Grisu(f, k, (f == 4503599627370496LL && be > 1), (void*)g, 20, &n, &*e)) {
+		n = Reals_Trim((void*)g, 20, n);
+		if (n <= p) {
+			k = 0;
+			while (k < n) {
+				d[__X(k, d__len)] = g[__X(k, 20)];
+				k += 1;
+			}
+			return n;
+		}
+		k = p;
+	} else if (x < 2.2250738585072014e-308) {
+		k = 1;
+	} else if (p < 15) {
+		k = p;
+	} else {
+		k = 15;
+	}
+	Reals_formatE(x, k - 1, (void*)s, 32);
+	while ((k < p && Reals_strtod(s, 32) != x)) {
+		k += 1;
+		Reals_formatE(x, k - 1, (void*)s, 32);
+	}
+	n = Reals_ScanE((void*)s, 32, (void*)d, d__len, &*e);
+	return Reals_Trim((void*)d, d__len, n);
+}
+
+INT16 Reals_Digits (REAL x, INT16 p, CHAR *d, ADDRESS d__len, INT16 *e)
+{
+	INT32 f;
+	INT16 be, k, n;
+	CHAR g[20];
+	CHAR s[32];
+	if (x < (REAL)0) {
+		x = -x;
+	}
+	if ((p <= 0 || p > 9)) {
+		p = 9;
+	}
+	if (x == (REAL)0) {
+		d[0] = '0';
+		*e = 0;
+		return 1;
+	}
+	f = __MASK((__VAL(INT32, x)), -8388608);
+	be = (INT16)__ASHR((__VAL(INT32, x)), 23);
+	if (be == 0) {
+		k = -149;
+	} else {
+		f += 8388608;
+		k = be - 150;
+	}
+	if (Reals_Grisu(f, k, (f == 8388608 && be > 1), (void*)g, 20, &n, &*e)) {
+		n = Reals_Trim((void*)g, 20, n);
+		if (n <= p) {
+			k = 0;
+			while (k < n) {
+				d[__X(k, d__len)] = g[__X(k, 20)];
+				k += 1;
+			}
+			return n;
+		}
+		k = p;
+	} else if (x < 1.1754944e-038) {
+		k = 1;
+	} else if (p < 6) {
+		k = p;
+	} else {
+		k = 6;
+	}
+	Reals_formatE((LONGREAL)x, k - 1, (void*)s, 32);
+	while ((k < p && Reals_strtof(s, 32) != x)) {
+		k += 1;
+		Reals_formatE((LONGREAL)x, k - 1, (void*)s, 32);
+	}
+	n = Reals_ScanE((void*)s, 32, (void*)d, d__len, &*e);
+	return Reals_Trim((void*)d, d__len, n);
+}
+
 static CHAR Reals_ToHex (INT16 i)
 {
 	if (i < 10) {
@@ -147,11 +528,119 @@ void Reals_ConvertHL (LONGREAL x, CHAR *d, ADDRESS d__len)
 	Reals_BytesToHex((void*)&x, 8, (void*)d, d__len * 1);
 }
 
+static void Reals_InitPowers (void)
+{
+	INT16 i;
+	Reals_ten[0] = (REAL)1;
+	Reals_tenL[0] = (LONGREAL)1;
+	i = 1;
+	while (i <= 22) {
+		if (i <= 10) {
+			Reals_ten[__X(i, 11)] = Reals_ten[__X(i - 1, 11)] * (REAL)10;
+		}
+		Reals_tenL[__X(i, 23)] = Reals_tenL[__X(i - 1, 23)] * (LONGREAL)10;
+		i += 1;
+	}
+	Reals_cacheF[0] = 4513721078614786210LL;
+	Reals_cacheF[1] = 3362984268825341918LL;
+	Reals_cacheF[2] = 2505618534107015966LL;
+	Reals_cacheF[3] = 3733662566702091643LL;
+	Reals_cacheF[4] = 2781795387493142219LL;
+	Reals_cacheF[5] = 4145198147733721464LL;
+	Reals_cacheF[6] = 3088413288990945715LL;
+	Reals_cacheF[7] = 4602094425247528724LL;
+	Reals_cacheF[8] = 3428827542996055427LL;
+	Reals_cacheF[9] = 2554675596204441359LL;
+	Reals_cacheF[10] = 3806763285703124641LL;
+	Reals_cacheF[11] = 2836259667354169965LL;
+	Reals_cacheF[12] = 4226356249085321971LL;
+	Reals_cacheF[13] = 3148880786512286939LL;
+	Reals_cacheF[14] = 2346099009001468822LL;
+	Reals_cacheF[15] = 3495959950985713038LL;
+	Reals_cacheF[16] = 2604693137843693076LL;
+	Reals_cacheF[17] = 3881295230751772338LL;
+	Reals_cacheF[18] = 2891790293717214717LL;
+	Reals_cacheF[19] = 4309103330548427577LL;
+	Reals_cacheF[20] = 3210532166472395939LL;
+	Reals_cacheF[21] = 2392032866531905487LL;
+	Reals_cacheF[22] = 3564406732517340015LL;
+	Reals_cacheF[23] = 2655689964083835493LL;
+	Reals_cacheF[24] = 3957286423569672545LL;
+	Reals_cacheF[25] = 2948408144391829181LL;
+	Reals_cacheF[26] = 4393470502483590218LL;
+	Reals_cacheF[27] = 3273390607896141870LL;
+	Reals_cacheF[28] = 2438866054934368931LL;
+	Reals_cacheF[29] = 3634193621478034453LL;
+	Reals_cacheF[30] = 2707685248164858261LL;
+	Reals_cacheF[31] = 4034765434510794671LL;
+	Reals_cacheF[32] = 3006134505950506532LL;
+	Reals_cacheF[33] = 4479489484355608421LL;
+	Reals_cacheF[34] = 3337479743626422004LL;
+	Reals_cacheF[35] = 2486616182048933211LL;
+	Reals_cacheF[36] = 3705346855594118254LL;
+	Reals_cacheF[37] = 2760698538716225515LL;
+	Reals_cacheF[38] = 4113761393303015105LL;
+	Reals_cacheF[39] = 3064991081731777717LL;
+	Reals_cacheF[40] = 4567192616659071619LL;
+	Reals_cacheF[41] = 3402823669209384635LL;
+	Reals_cacheF[42] = 2535301200456458803LL;
+	Reals_cacheF[43] = 3777893186295716171LL;
+	Reals_cacheF[44] = 2814749767106560000LL;
+	Reals_cacheF[45] = 4194304000000000000LL;
+	Reals_cacheF[46] = 3125000000000000000LL;
+	Reals_cacheF[47] = 2328306436538696289LL;
+	Reals_cacheF[48] = 3469446951953614189LL;
+	Reals_cacheF[49] = 2584939414228211484LL;
+	Reals_cacheF[50] = 3851859888774471706LL;
+	Reals_cacheF[51] = 2869859254937225361LL;
+	Reals_cacheF[52] = 4276423536147513034LL;
+	Reals_cacheF[53] = 3186183822264904554LL;
+	Reals_cacheF[54] = 2373891936439949687LL;
+	Reals_cacheF[55] = 3537374640166684519LL;
+	Reals_cacheF[56] = 2635549485807630806LL;
+	Reals_cacheF[57] = 3927274772238181242LL;
+	Reals_cacheF[58] = 2926047721682623954LL;
+	Reals_cacheF[59] = 4360150876168346337LL;
+	Reals_cacheF[60] = 3248565551764031006LL;
+	Reals_cacheF[61] = 2420369946780823921LL;
+	Reals_cacheF[62] = 3606632272572553039LL;
+	Reals_cacheF[63] = 2687150443026835501LL;
+	Reals_cacheF[64] = 4004166190366201849LL;
+	Reals_cacheF[65] = 2983336292480082697LL;
+	Reals_cacheF[66] = 4445517498970154967LL;
+	Reals_cacheF[67] = 3312168642111238068LL;
+	Reals_cacheF[68] = 2467757941865353337LL;
+	Reals_cacheF[69] = 3677245887913336361LL;
+	Reals_cacheF[70] = 2739761686260503800LL;
+	Reals_cacheF[71] = 4082563051969563663LL;
+	Reals_cacheF[72] = 3041746506072255718LL;
+	Reals_cacheF[73] = 4532555499780559119LL;
+	Reals_cacheF[74] = 3377017006114541828LL;
+	Reals_cacheF[75] = 2516073738123880199LL;
+	Reals_cacheF[76] = 3749242034739077387LL;
+	Reals_cacheF[77] = 2793402995719818314LL;
+	Reals_cacheF[78] = 4162494831859794727LL;
+	Reals_cacheF[79] = 3101300322905029898LL;
+	Reals_cacheF[80] = 2310648801106981857LL;
+	Reals_cacheF[81] = 3443135024766596939LL;
+	Reals_cacheF[82] = 2565335500811485156LL;
+	Reals_cacheF[83] = 3822647781389184528LL;
+	Reals_cacheF[84] = 2848094538889217770LL;
+	Reals_cacheF[85] = 4243991581930544630LL;
+	Reals_cacheF[86] = 3162020133383977883LL;
+	i = 0;
+	while (i < 87) {
+		Reals_cacheE[__X(i, 87)] = __ASHR((-348 + 8 * i) * 1741647, 19) - 61;
+		i += 1;
+	}
+}
+
 
 export void *Reals__init(void)
 {
 	__DEFMOD;
 	__REGMOD("Reals", 0);
 /* BEGIN */
+	Reals_InitPowers();
 	__ENDMOD;
 }
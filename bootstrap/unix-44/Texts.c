@@ -753,8 +753,8 @@ void Texts_Scan (Texts_Scanner *S, ADDRESS *S__typ)
 	INT8 i, j, h;
 	INT16 e;
 	INT32 k;
-	REAL x, f;
-	LONGREAL y, g;
+	REAL x;
+	LONGREAL y;
 	CHAR d[32];
 	struct Scan__31 _s;
 	_s.S = S; _s.S__typ = S__typ;
@@ -853,29 +853,17 @@ void Texts_Scan (Texts_Scanner *S, ADDRESS *S__typ)
 				if (ch == 'D') {
 					e = 0;
 					y = (LONGREAL)0;
-					g = (LONGREAL)1;
-					do {
-						y = y * (LONGREAL)10 + ((INT16)d[__X(j, 32)] - 48);
-						j += 1;
-					} while (!(j == h));
-					while (j < i) {
-						g = g / (LONGREAL)(LONGREAL)10;
-						y = ((INT16)d[__X(j, 32)] - 48) * g + y;
-						j += 1;
-					}
 					ReadScaleFactor__32();
 					if (negE) {
 						if (e <= 308) {
-							y = y / (LONGREAL)Reals_TenL(e);
+							y = Reals_DecimalL((void*)d, 32, i, -e - (i - h));
 						} else {
 							y = (LONGREAL)0;
 						}
-					} else if (e > 0) {
-						if (e <= 308) {
-							y = Reals_TenL(e) * y;
-						} else {
-							__HALT(40);
-						}
+					} else if (e <= 308) {
+						y = Reals_DecimalL((void*)d, 32, i, e - (i - h));
+					} else {
+						__HALT(40);
 					}
 					if (neg) {
 						y = -y;
@@ -884,32 +872,21 @@ void Texts_Scan (Texts_Scanner *S, ADDRESS *S__typ)
 					(*S).y = y;
 				} else {
 					e = 0;
+					negE = 0;
 					x = (REAL)0;
-					f = (REAL)1;
-					do {
-						x = x * (REAL)10 + ((INT16)d[__X(j, 32)] - 48);
-						j += 1;
-					} while (!(j == h));
-					while (j < i) {
-						f = f / (REAL)(REAL)10;
-						x = ((INT16)d[__X(j, 32)] - 48) * f + x;
-						j += 1;
-					}
 					if (ch == 'E') {
 						ReadScaleFactor__32();
 					}
 					if (negE) {
 						if (e <= 38) {
-							x = x / (REAL)Reals_Ten(e);
+							x = Reals_Decimal((void*)d, 32, i, -e - (i - h));
 						} else {
 							x = (REAL)0;
 						}
-					} else if (e > 0) {
-						if (e <= 38) {
-							x = Reals_Ten(e) * x;
-						} else {
-							__HALT(40);
-						}
+					} else if (e <= 38) {
+						x = Reals_Decimal((void*)d, 32, i, e - (i - h));
+					} else {
+						__HALT(40);
 					}
 					if (neg) {
 						x = -x;
@@ -1100,8 +1077,7 @@ void Texts_WriteHex (Texts_Writer *W, ADDRESS *W__typ, INT32 x)
 
 void Texts_WriteReal (Texts_Writer *W, ADDRESS *W__typ, REAL x, INT16 n)
 {
-	INT16 e;
-	REAL x0;
+	INT16 e, i, k;
 	CHAR d[9];
 	e = Reals_Expo(x);
 	if (e == 0) {
@@ -1132,30 +1108,18 @@ void Texts_WriteReal (Texts_Writer *W, ADDRESS *W__typ, REAL x, INT16 n)
 		} else {
 			Texts_Write(&*W, W__typ, ' ');
 		}
-		e = __ASHR((e - 127) * 77, 8);
-		if (e >= 0) {
-			x = x / (REAL)Reals_Ten(e);
-		} else {
-			x = Reals_Ten(-e) * x;
-		}
-		if (x >= (REAL)10) {
-			x =   1.0000000e-001 * x;
-			e += 1;
-		}
-		x0 = Reals_Ten(n - 1);
-		x = x0 * x +   5.0000000e-001;
-		if (x >= (REAL)10 * x0) {
-			x = x *   1.0000000e-001;
-			e += 1;
-		}
-		Reals_Convert(x, n, (void*)d, 9);
-		n -= 1;
-		Texts_Write(&*W, W__typ, d[__X(n, 9)]);
+		k = Reals_Digits(x, n, (void*)d, 9, &e);
+		Texts_Write(&*W, W__typ, d[0]);
 		Texts_Write(&*W, W__typ, '.');
+		i = 1;
 		do {
-			n -= 1;
-			Texts_Write(&*W, W__typ, d[__X(n, 9)]);
-		} while (!(n == 0));
+			if (i < k) {
+				Texts_Write(&*W, W__typ, d[__X(i, 9)]);
+			} else {
+				Texts_Write(&*W, W__typ, '0');
+			}
+			i += 1;
+		} while (!(i >= n));
 		Texts_Write(&*W, W__typ, 'E');
 		if (e < 0) {
 			Texts_Write(&*W, W__typ, '-');
@@ -1282,8 +1246,7 @@ void Texts_WriteRealHex (Texts_Writer *W, ADDRESS *W__typ, REAL x)
 
 void Texts_WriteLongReal (Texts_Writer *W, ADDRESS *W__typ, LONGREAL x, INT16 n)
 {
-	INT16 e;
-	LONGREAL x0;
+	INT16 e, i, k;
 	CHAR d[16];
 	e = Reals_ExpoL(x);
 	if (e == 0) {
@@ -1314,30 +1277,18 @@ void Texts_WriteLongReal (Texts_Writer *W, ADDRESS *W__typ, LONGREAL x, INT16 n)
 		} else {
 			Texts_Write(&*W, W__typ, ' ');
 		}
-		e = __SHORT(__ASHR((e - 1023) * 77, 8), 32768);
-		if (e >= 0) {
-			x = x / (LONGREAL)Reals_TenL(e);
-		} else {
-			x = Reals_TenL(-e) * x;
-		}
-		if (x >= (LONGREAL)10) {
-			x =   1.00000000000000e-001 * x;
-			e += 1;
-		}
-		x0 = Reals_TenL(n - 1);
-		x = x0 * x +   5.00000000000000e-001;
-		if (x >= (LONGREAL)10 * x0) {
-			x =   1.00000000000000e-001 * x;
-			e += 1;
-		}
-		Reals_ConvertL(x, n, (void*)d, 16);
-		n -= 1;
-		Texts_Write(&*W, W__typ, d[__X(n, 16)]);
+		k = Reals_DigitsL(x, n, (void*)d, 16, &e);
+		Texts_Write(&*W, W__typ, d[0]);
 		Texts_Write(&*W, W__typ, '.');
+		i = 1;
 		do {
-			n -= 1;
-			Texts_Write(&*W, W__typ, d[__X(n, 16)]);
-		} while (!(n == 0));
+			if (i < k) {
+				Texts_Write(&*W, W__typ, d[__X(i, 16)]);
+			} else {
+				Texts_Write(&*W, W__typ, '0');
+			}
+			i += 1;
+		} while (!(i >= n));
 		Texts_Write(&*W, W__typ, 'D');
 		if (e < 0) {
 			Texts_Write(&*W, W__typ, '-');
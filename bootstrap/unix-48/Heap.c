@@ -76,6 +76,12 @@ static Heap_FinNode Heap_fin;
 static INT16 Heap_lockdepth;
 static BOOLEAN Heap_interrupted;
 export INT16 Heap_FileCount;
+static INT32 Heap_region, Heap_regionChunk, Heap_regionAdr, Heap_regionEnd;
+export INT32 Heap_regionsize;
+export INT32 Heap_collections;
+export INT32 Heap_highWater;
+export INT64 Heap_allocatedTotal, Heap_pauseTotal, Heap_pauseMax;
+export INT32 Heap_pauses[24];
 
 export ADDRESS *Heap_ModuleDesc__typ;
 export ADDRESS *Heap_CmdDesc__typ;
@@ -96,24 +102,32 @@ static void Heap_Mark (INT32 q);
 static void Heap_MarkCandidates (INT32 n, INT32 *cand, ADDRESS cand__len);
 static void Heap_MarkP (SYSTEM_PTR p);
 static void Heap_MarkStack (INT32 n, INT32 *cand, ADDRESS cand__len);
+static INT64 Heap_Microseconds (void);
 export SYSTEM_PTR Heap_NEWBLK (INT32 size);
 export SYSTEM_PTR Heap_NEWREC (INT32 tag);
 static INT32 Heap_NewChunk (INT32 blksz);
+static void Heap_NewRegionChunk (INT32 blksz);
 export void Heap_REGCMD (Heap_Module m, Heap_CmdName name, Heap_Command cmd);
 export SYSTEM_PTR Heap_REGMOD (Heap_ModuleName name, Heap_EnumProc enumPtrs);
 export void Heap_REGTYP (Heap_Module m, INT32 typ);
+static void Heap_RecordPause (INT64 start);
+export SYSTEM_PTR Heap_RegionBlk (INT32 size);
+export SYSTEM_PTR Heap_RegionRec (INT32 tag);
 export void Heap_RegisterFinalizer (SYSTEM_PTR obj, Heap_Finalizer finalize);
+export void Heap_ReleaseRegion (void);
 static void Heap_Scan (void);
 static void Heap_Sift (INT32 l, INT32 r, INT32 *a, ADDRESS a__len);
 export void Heap_Unlock (void);
 
 extern void *Heap__init();
 extern ADDRESS Modules_MainStackFrame;
+extern void Platform_GetTimeOfDay(INT32 *sec, INT32 *usec);
 extern ADDRESS Platform_OSAllocate(ADDRESS size);
 #define Heap_HeapModuleInit()	Heap__init()
 #define Heap_ModulesHalt(code)	Modules_Halt(code)
 #define Heap_ModulesMainStackFrame()	Modules_MainStackFrame
 #define Heap_OSAllocate(size)	Platform_OSAllocate(size)
+#define Heap_PlatformGetTimeOfDay(sec, usec)	Platform_GetTimeOfDay(sec, usec)
 #define Heap_uLE(x, y)	((size_t)x <= (size_t)y)
 #define Heap_uLT(x, y)	((size_t)x <  (size_t)y)
 
@@ -354,6 +368,7 @@ SYSTEM_PTR Heap_NEWREC (INT32 tag)
 	__PUT(adr + 4, 0, INT32);
 	__PUT(adr + 8, 0, INT32);
 	Heap_allocated += blksz;
+	Heap_allocatedTotal += blksz;
 	Heap_Unlock();
 	return (SYSTEM_PTR)(ADDRESS)(adr + 4);
 }
@@ -374,6 +389,96 @@ SYSTEM_PTR Heap_NEWBLK (INT32 size)
 	return new;
 }
 
+static void Heap_NewRegionChunk (INT32 blksz)
+{
+	INT32 chnk, next, end, size;
+	if (Heap_regionChunk == 0) {
+		next = Heap_region;
+	} else {
+		__GET(Heap_regionChunk, next, INT32);
+	}
+	chnk = next;
+	if (chnk != 0) {
+		__GET(chnk + 4, end, INT32);
+	}
+	if (chnk == 0 || Heap_uLT((end - chnk) - 8, blksz)) {
+		size = 262144;
+		if (Heap_uLT(size - 8, blksz)) {
+			size = blksz + 8;
+		}
+		chnk = Heap_OSAllocate(size);
+		if (chnk == 0) {
+			return;
+		}
+		end = chnk + size;
+		__PUT(chnk, next, INT32);
+		__PUT(chnk + 4, end, INT32);
+		if (Heap_regionChunk == 0) {
+			Heap_region = chnk;
+		} else {
+			__PUT(Heap_regionChunk, chnk, INT32);
+		}
+		Heap_regionsize += size;
+	}
+	Heap_regionChunk = chnk;
+	Heap_regionAdr = chnk + 8;
+	Heap_regionEnd = end;
+}
+
+SYSTEM_PTR Heap_RegionRec (INT32 tag)
+{
+	INT32 i, adr, end, blksz;
+	Heap_Lock();
+	__GET(tag, blksz, INT32);
+	if (Heap_uLT(Heap_regionEnd - Heap_regionAdr, blksz)) {
+		Heap_NewRegionChunk(blksz);
+		if (Heap_uLT(Heap_regionEnd - Heap_regionAdr, blksz)) {
+			Heap_Unlock();
+			return NIL;
+		}
+	}
+	adr = Heap_regionAdr;
+	Heap_regionAdr += blksz;
+	i = adr + 16;
+	end = adr + blksz;
+	while (Heap_uLT(i, end)) {
+		__PUT(i, 0, INT32);
+		__PUT(i + 4, 0, INT32);
+		__PUT(i + 8, 0, INT32);
+		__PUT(i + 12, 0, INT32);
+		i += 16;
+	}
+	__PUT(adr + 12, 0, INT32);
+	__PUT(adr, tag + 1, INT32);
+	__PUT(adr + 4, 0, INT32);
+	__PUT(adr + 8, 0, INT32);
+	Heap_Unlock();
+	return (SYSTEM_PTR)(ADDRESS)(adr + 4);
+}
+
+SYSTEM_PTR Heap_RegionBlk (INT32 size)
+{
+	INT32 blksz, tag;
+	SYSTEM_PTR new;
+	Heap_Lock();
+	blksz = __ASHL(__ASHR(size + 31, 4), 4);
+	new = Heap_RegionRec((ADDRESS)&blksz);
+	tag = ((INT32)(ADDRESS)new + blksz) - 12;
+	__PUT(tag - 4, 0, INT32);
+	__PUT(tag, blksz, INT32);
+	__PUT(tag + 4, -4, INT32);
+	__PUT((INT32)(ADDRESS)new - 4, tag + 1, INT32);
+	Heap_Unlock();
+	return new;
+}
+
+void Heap_ReleaseRegion (void)
+{
+	Heap_regionChunk = 0;
+	Heap_regionAdr = 0;
+	Heap_regionEnd = 0;
+}
+
 static void Heap_Mark (INT32 q)
 {
 	INT32 p, tag, offset, fld, n, tagbits;
@@ -660,12 +765,41 @@ static void Heap_MarkStack (INT32 n, INT32 *cand, ADDRESS cand__len)
 	}
 }
 
+static INT64 Heap_Microseconds (void)
+{
+	INT32 sec, usec;
+	Heap_PlatformGetTimeOfDay(&sec, &usec);
+	return (INT64)sec * 1000000 + (INT64)usec;
+}
+
+static void Heap_RecordPause (INT64 start)
+{
+	INT64 d;
+	INT16 i;
+	d = Heap_Microseconds() - start;
+	Heap_pauseTotal += d;
+	if (d > Heap_pauseMax) {
+		Heap_pauseMax = d;
+	}
+	i = 0;
+	while ((i < 23 && __ASHL(1, i) <= d)) {
+		i += 1;
+	}
+	Heap_pauses[i] += 1;
+}
+
 void Heap_GC (BOOLEAN markStack)
 {
 	Heap_Module m;
 	INT32 i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15, i16, i17, i18, i19, i20, i21, i22, i23;
 	INT32 cand[10000];
+	INT64 start;
 	Heap_Lock();
+	start = Heap_Microseconds();
+	Heap_collections += 1;
+	if (Heap_allocated > Heap_highWater) {
+		Heap_highWater = Heap_allocated;
+	}
 	m = (Heap_Module)(ADDRESS)Heap_modules;
 	while (m != NIL) {
 		if (m->enumPtrs != NIL) {
@@ -735,6 +869,7 @@ void Heap_GC (BOOLEAN markStack)
 	Heap_CheckFin();
 	Heap_Scan();
 	Heap_Finalize();
+	Heap_RecordPause(start);
 	Heap_Unlock();
 }
 
@@ -765,6 +900,9 @@ void Heap_InitHeap (void)
 	Heap_firstTry = 1;
 	Heap_freeList[9] = 1;
 	Heap_FileCount = 0;
+	Heap_region = 0;
+	Heap_regionsize = 0;
+	Heap_ReleaseRegion();
 	Heap_modules = NIL;
 	Heap_fin = NIL;
 	Heap_interrupted = 0;
@@ -789,6 +927,7 @@ export void *Heap__init(void)
 	__REGCMD("FINALL", Heap_FINALL);
 	__REGCMD("InitHeap", Heap_InitHeap);
 	__REGCMD("Lock", Heap_Lock);
+	__REGCMD("ReleaseRegion", Heap_ReleaseRegion);
 	__REGCMD("Unlock", Heap_Unlock);
 	__INITYP(Heap_ModuleDesc, Heap_ModuleDesc, 0);
 	__INITYP(Heap_CmdDesc, Heap_CmdDesc, 0);
@@ -8,12 +8,12 @@
 #include "SYSTEM.h"
 #include "Configuration.h"
 #include "OPM.h"
+#include "OPS.h"
 #include "OPT.h"
 
 
 static INT16 OPC_indentLevel;
-static INT8 OPC_hashtab[105];
-static CHAR OPC_keytab[50][9];
+static OPS_Ident OPC_keytab[128];
 static BOOLEAN OPC_GlbPtrs;
 static CHAR OPC_BodyNameExt[13];
 
@@ -63,6 +63,7 @@ export void OPC_Indent (INT16 count);
 export void OPC_Init (void);
 static void OPC_InitImports (OPT_Object obj);
 static void OPC_InitKeywords (void);
+static INT16 OPC_KeySlot (OPS_Ident name);
 export void OPC_InitTDesc (OPT_Struct typ);
 static void OPC_InitTProcs (OPT_Object typ, OPT_Object obj);
 export void OPC_IntLiteral (INT64 n, INT32 size);
@@ -71,7 +72,6 @@ static void OPC_LenList (OPT_Object par, BOOLEAN ansiDefine, BOOLEAN showParamNa
 static INT16 OPC_Length (CHAR *s, ADDRESS s__len);
 export BOOLEAN OPC_NeedsRetval (OPT_Object proc);
 export INT32 OPC_NofPtrs (OPT_Struct typ);
-static INT16 OPC_PerfectHash (CHAR *s, ADDRESS s__len);
 static BOOLEAN OPC_Prefixed (OPT_ConstExt x, CHAR *y, ADDRESS y__len);
 static void OPC_ProcHeader (OPT_Object proc, BOOLEAN define);
 static void OPC_ProcPredefs (OPT_Object obj, INT8 vis);
@@ -166,16 +166,9 @@ static INT16 OPC_Length (CHAR *s, ADDRESS s__len)
 	return i;
 }
 
-static INT16 OPC_PerfectHash (CHAR *s, ADDRESS s__len)
+static INT16 OPC_KeySlot (OPS_Ident name)
 {
-	INT16 i, h;
-	i = 0;
-	h = 0;
-	while ((s[__X(i, s__len)] != 0x00 && i < 5)) {
-		h = 3 * h + (INT16)s[__X(i, s__len)];
-		i += 1;
-	}
-	return (int)__MOD(h, 105);
+	return (INT16)__MASK((ADDRESS)name >> 4, -128);
 }
 
 void OPC_Ident (OPT_Object obj)
@@ -184,12 +177,13 @@ void OPC_Ident (OPT_Object obj)
 	mode = obj->mode;
 	level = obj->mnolev;
 	if ((__IN(mode, 0x62, 32) && level > 0) || __IN(mode, 0x14, 32)) {
-		OPM_WriteStringVar((void*)obj->name, 256);
-		h = OPC_PerfectHash((void*)obj->name, 256);
-		if (OPC_hashtab[__X(h, 105)] >= 0) {
-			if (__STRCMP(OPC_keytab[__X(OPC_hashtab[__X(h, 105)], 50)], obj->name) == 0) {
-				OPM_Write('_');
-			}
+		OPM_WriteStringVar((void*)obj->name->data, obj->name->len[0]);
+		h = OPC_KeySlot(obj->name);
+		while ((OPC_keytab[__X(h, 128)] != NIL && OPC_keytab[__X(h, 128)] != obj->name)) {
+			h = __MASK(h + 1, -128);
+		}
+		if (OPC_keytab[__X(h, 128)] != NIL) {
+			OPM_Write('_');
 		}
 	} else if ((mode == 5 && __IN(obj->typ->form, 0x90, 32))) {
 		if (obj->typ == OPT_adrtyp) {
@@ -207,7 +201,7 @@ void OPC_Ident (OPT_Object obj)
 			if (mode == 13) {
 				OPC_Ident(obj->link->typ->strobj);
 			} else if (level < 0) {
-				OPM_WriteStringVar((void*)OPT_GlbMod[__X(-level, 64)]->name, 256);
+				OPM_WriteStringVar((void*)OPT_GlbMod[__X(-level, 64)]->name->data, OPT_GlbMod[__X(-level, 64)]->name->len[0]);
 				if (OPM_currFile == 0) {
 					OPT_GlbMod[__X(-level, 64)]->vis = 1;
 				}
@@ -218,7 +212,7 @@ void OPC_Ident (OPT_Object obj)
 		} else if (obj == OPT_sysptrtyp->strobj || obj == OPT_bytetyp->strobj) {
 			OPM_WriteString((CHAR*)"SYSTEM_", 8);
 		}
-		OPM_WriteStringVar((void*)obj->name, 256);
+		OPM_WriteStringVar((void*)obj->name->data, obj->name->len[0]);
 	}
 }
 
@@ -226,7 +220,7 @@ static void OPC_Stars (OPT_Struct typ, BOOLEAN *openClause)
 {
 	INT16 pointers;
 	*openClause = 0;
-	if (((typ->strobj == NIL || typ->strobj->name[0] == 0x00) && typ->comp != 4)) {
+	if (((typ->strobj == NIL || (typ->strobj->name->data)[0] == 0x00) && typ->comp != 4)) {
 		if (__IN(typ->comp, 0x0c, 32)) {
 			OPC_Stars(typ->BaseTyp, &*openClause);
 			*openClause = typ->comp == 2;
@@ -235,7 +229,7 @@ static void OPC_Stars (OPT_Struct typ, BOOLEAN *openClause)
 			OPM_Write('*');
 		} else {
 			pointers = 0;
-			while (((typ->strobj == NIL || typ->strobj->name[0] == 0x00) && typ->form == 11)) {
+			while (((typ->strobj == NIL || (typ->strobj->name->data)[0] == 0x00) && typ->form == 11)) {
 				pointers += 1;
 				typ = typ->BaseTyp;
 			}
@@ -270,7 +264,7 @@ static void OPC_DeclareObj (OPT_Object dcl, BOOLEAN scopeDef)
 		}
 		OPM_Write('*');
 	}
-	if (dcl->name[0] != 0x00) {
+	if ((dcl->name->data)[0] != 0x00) {
 		OPC_Ident(dcl);
 	}
 	if ((varPar && openClause)) {
@@ -280,7 +274,7 @@ static void OPC_DeclareObj (OPT_Object dcl, BOOLEAN scopeDef)
 	for (;;) {
 		form = typ->form;
 		comp = typ->comp;
-		if (((typ->strobj != NIL && typ->strobj->name[0] != 0x00) || form == 10) || comp == 4) {
+		if (((typ->strobj != NIL && (typ->strobj->name->data)[0] != 0x00) || form == 10) || comp == 4) {
 			break;
 		} else if ((form == 11 && typ->BaseTyp->comp != 3)) {
 			openClause = 1;
@@ -317,7 +311,7 @@ void OPC_Andent (OPT_Struct typ)
 
 static BOOLEAN OPC_Undefined (OPT_Object obj)
 {
-	return obj->name[0] == 0x00 || (((obj->mnolev >= 0 && obj->linkadr != (3 + OPM_currFile))) && obj->linkadr != 2);
+	return (obj->name->data)[0] == 0x00 || (((obj->mnolev >= 0 && obj->linkadr != (3 + OPM_currFile))) && obj->linkadr != 2);
 }
 
 static void OPC_DeclareBase (OPT_Object dcl)
@@ -340,7 +334,7 @@ static void OPC_DeclareBase (OPT_Object dcl)
 	} else if (typ->comp == 4) {
 		OPM_WriteString((CHAR*)"struct ", 8);
 		OPC_Andent(typ);
-		if ((prev->form != 11 && (obj != NIL || dcl->name[0] == 0x00))) {
+		if ((prev->form != 11 && (obj != NIL || (dcl->name->data)[0] == 0x00))) {
 			if ((typ->BaseTyp != NIL && typ->BaseTyp->strobj->vis != 0)) {
 				OPM_WriteString((CHAR*)" { /* ", 7);
 				OPC_Ident(typ->BaseTyp->strobj);
@@ -374,7 +368,7 @@ static void OPC_DeclareBase (OPT_Object dcl)
 		obj->typ->n = 1;
 		obj->typ->BaseTyp = typ;
 		obj->mode = 4;
-		__MOVE("data", obj->name, 5);
+		obj->name = OPS_Intern((CHAR*)"data", 5);
 		obj->linkadr = 0;
 		OPC_DeclareBase(obj);
 		OPM_Write(' ');
@@ -400,7 +394,7 @@ INT32 OPC_NofPtrs (OPT_Struct typ)
 		}
 		fld = typ->link;
 		while ((fld != NIL && fld->mode == 4)) {
-			if (__STRCMP(fld->name, "@ptr") != 0) {
+			if (__STRCMP(fld->name->data, "@ptr") != 0) {
 				n = n + OPC_NofPtrs(fld->typ);
 			} else {
 				n += 1;
@@ -442,7 +436,7 @@ static void OPC_PutPtrOffsets (OPT_Struct typ, INT32 adr, INT32 *cnt)
 		}
 		fld = typ->link;
 		while ((fld != NIL && fld->mode == 4)) {
-			if (__STRCMP(fld->name, "@ptr") != 0) {
+			if (__STRCMP(fld->name->data, "@ptr") != 0) {
 				OPC_PutPtrOffsets(fld->typ, adr + fld->adr, &*cnt);
 			} else {
 				OPM_WriteInt(adr + fld->adr);
@@ -530,7 +524,7 @@ static void OPC_DeclareParams (OPT_Object par, BOOLEAN macro)
 	OPM_Write('(');
 	while (par != NIL) {
 		if (macro) {
-			OPM_WriteStringVar((void*)par->name, 256);
+			OPM_WriteStringVar((void*)par->name->data, par->name->len[0]);
 		} else {
 			if ((par->mode == 1 && par->typ->form == 5)) {
 				OPM_Write('_');
@@ -542,7 +536,7 @@ static void OPC_DeclareParams (OPT_Object par, BOOLEAN macro)
 			OPC_LenList(par, 0, 1);
 		} else if ((par->mode == 2 && par->typ->comp == 4)) {
 			OPM_WriteString((CHAR*)", ", 3);
-			OPM_WriteStringVar((void*)par->name, 256);
+			OPM_WriteStringVar((void*)par->name->data, par->name->len[0]);
 			OPM_WriteString((CHAR*)"__typ", 6);
 		}
 		par = par->link;
@@ -610,7 +604,7 @@ OPT_Object OPC_BaseTProc (OPT_Object obj)
 		typ = base;
 		base = typ->BaseTyp;
 	}
-	OPT_FindField(obj->name, typ, &obj);
+	OPT_FindField(obj->name->data, typ, &obj);
 	return obj;
 }
 
@@ -785,7 +779,7 @@ static void OPC_DefAnonRecs (OPT_Node n)
 			OPC_DefineType(typ);
 			__NEW(o, OPT_ObjDesc);
 			o->typ = typ;
-			o->name[0] = 0x00;
+			o->name = OPS_Intern((CHAR*)"", 1);
 			OPC_DeclareBase(o);
 			OPC_EndStat();
 			OPM_WriteLn();
@@ -805,7 +799,7 @@ void OPC_TDescDecl (OPT_Struct typ)
 	OPC_Str1((CHAR*)", #) = {__TDFLDS(", 18, OPC_NofPtrs(typ));
 	OPM_Write('"');
 	if (typ->strobj != NIL) {
-		OPM_WriteStringVar((void*)typ->strobj->name, 256);
+		OPM_WriteStringVar((void*)typ->strobj->name->data, typ->strobj->name->len[0]);
 	}
 	OPM_Write('"');
 	OPC_Str1((CHAR*)", #), {", 8, typ->size);
@@ -995,7 +989,7 @@ static void OPC_IdentList (OPT_Object obj, INT16 vis)
 
 static void OPC_AnsiParamList (OPT_Object obj, BOOLEAN showParamNames)
 {
-	CHAR name[32];
+	OPS_Ident name = NIL;
 	OPM_Write('(');
 	if (obj == NIL || obj->mode == 13) {
 		OPM_WriteString((CHAR*)"void", 5);
@@ -1006,10 +1000,10 @@ static void OPC_AnsiParamList (OPT_Object obj, BOOLEAN showParamNames)
 				OPM_Write(' ');
 				OPC_DeclareObj(obj, 0);
 			} else {
-				__COPY(obj->name, name, 32);
-				obj->name[0] = 0x00;
+				name = obj->name;
+				obj->name = OPS_Intern((CHAR*)"", 1);
 				OPC_DeclareObj(obj, 0);
-				__COPY(name, obj->name, 256);
+				obj->name = name;
 			}
 			if (obj->typ->comp == 3) {
 				OPM_WriteString((CHAR*)", ADDRESS ", 11);
@@ -1083,7 +1077,7 @@ static void OPC_IncludeImports (OPT_Object obj, INT16 vis)
 	if (obj != NIL) {
 		OPC_IncludeImports(obj->left, vis);
 		if ((((obj->mode == 11 && obj->mnolev != 0)) && (INT16)OPT_GlbMod[__X(-obj->mnolev, 64)]->vis >= vis)) {
-			OPC_Include(OPT_GlbMod[__X(-obj->mnolev, 64)]->name, 256);
+			OPC_Include(OPT_GlbMod[__X(-obj->mnolev, 64)]->name->data, OPT_GlbMod[__X(-obj->mnolev, 64)]->name->len[0]);
 		}
 		OPC_IncludeImports(obj->right, vis);
 	}
@@ -1140,7 +1134,7 @@ static void OPC_GenHeaderMsg (void)
 {
 	INT16 i;
 	OPM_WriteString((CHAR*)"/* ", 4);
-	OPM_WriteString((CHAR*)"scream", 4);
+	OPM_WriteString((CHAR*)"scream", 7);
 	OPM_Write(' ');
 	OPM_WriteString(Configuration_versionLong, 76);
 	OPM_Write(' ');
@@ -1190,6 +1184,18 @@ static void OPC_GenHeaderMsg (void)
 				case 18: 
 					OPM_Write('v');
 					break;
+				case 19: 
+					OPM_Write('i');
+					break;
+				case 20: 
+					OPM_Write('U');
+					break;
+				case 21: 
+					OPM_Write('T');
+					break;
+				case 22: 
+					OPM_Write('o');
+					break;
 				default: 
 					OPM_LogWStr((CHAR*)"( more options defined in OPM than checked in OPC.GenHeaderMsg, if you are a compiler developer, add them to OPC.GenHeaderMsg", 126);
 					OPM_LogWLn();
@@ -1263,7 +1269,7 @@ static void OPC_RegCmds (OPT_Object obj)
 			if ((((obj->vis != 0 && obj->link == NIL)) && obj->typ == OPT_notyp)) {
 				OPC_BegStat();
 				OPM_WriteString((CHAR*)"__REGCMD(\"", 11);
-				OPM_WriteStringVar((void*)obj->name, 256);
+				OPM_WriteStringVar((void*)obj->name->data, obj->name->len[0]);
 				OPM_WriteString((CHAR*)"\", ", 4);
 				OPC_Ident(obj);
 				OPM_Write(')');
@@ -1281,7 +1287,7 @@ static void OPC_InitImports (OPT_Object obj)
 		if ((obj->mode == 11 && obj->mnolev != 0)) {
 			OPC_BegStat();
 			OPM_WriteString((CHAR*)"__MODULE_IMPORT(", 17);
-			OPM_WriteStringVar((void*)OPT_GlbMod[__X(-obj->mnolev, 64)]->name, 256);
+			OPM_WriteStringVar((void*)OPT_GlbMod[__X(-obj->mnolev, 64)]->name->data, OPT_GlbMod[__X(-obj->mnolev, 64)]->name->len[0]);
 			OPM_Write(')');
 			OPC_EndStat();
 		}
@@ -1410,14 +1416,14 @@ void OPC_DefineInter (OPT_Object proc)
 	scope = proc->scope;
 	OPM_WriteString((CHAR*)"static ", 8);
 	OPM_WriteString((CHAR*)"struct ", 8);
-	OPM_WriteStringVar((void*)scope->name, 256);
+	OPM_WriteStringVar((void*)scope->name->data, scope->name->len[0]);
 	OPM_Write(' ');
 	OPC_BegBlk();
 	OPC_IdentList(proc->link, 3);
 	OPC_IdentList(scope->scope, 3);
 	OPC_BegStat();
 	OPM_WriteString((CHAR*)"struct ", 8);
-	OPM_WriteStringVar((void*)scope->name, 256);
+	OPM_WriteStringVar((void*)scope->name->data, scope->name->len[0]);
 	OPM_Write(' ');
 	OPM_Write('*');
 	OPM_WriteString((CHAR*)"lnk", 4);
@@ -1425,7 +1431,7 @@ void OPC_DefineInter (OPT_Object proc)
 	OPC_EndBlk0();
 	OPM_Write(' ');
 	OPM_Write('*');
-	OPM_WriteStringVar((void*)scope->name, 256);
+	OPM_WriteStringVar((void*)scope->name->data, scope->name->len[0]);
 	OPM_WriteString((CHAR*)"_s", 3);
 	OPC_EndStat();
 	OPM_WriteLn();
@@ -1453,7 +1459,7 @@ void OPC_EnterProc (OPT_Object proc)
 	if (!scope->leaf) {
 		OPC_BegStat();
 		OPM_WriteString((CHAR*)"struct ", 8);
-		OPM_WriteStringVar((void*)scope->name, 256);
+		OPM_WriteStringVar((void*)scope->name->data, scope->name->len[0]);
 		OPM_Write(' ');
 		OPM_WriteString((CHAR*)"_s", 3);
 		OPC_EndStat();
@@ -1466,7 +1472,7 @@ void OPC_EnterProc (OPT_Object proc)
 	}
 	var = proc->link;
 	while (var != NIL) {
-		if ((var->typ->comp == 2 && var->mode == 1)) {
+		if ((((var->typ->comp == 2 && var->mode == 1)) && !var->nocopy)) {
 			OPC_BegStat();
 			if (var->typ->strobj == NIL) {
 				OPM_Mark(200, var->typ->txtpos);
@@ -1482,7 +1488,7 @@ void OPC_EnterProc (OPT_Object proc)
 	}
 	var = proc->link;
 	while (var != NIL) {
-		if ((((__IN(var->typ->comp, 0x0c, 32) && var->mode == 1)) && var->typ->sysflag == 0)) {
+		if ((((((__IN(var->typ->comp, 0x0c, 32) && var->mode == 1)) && var->typ->sysflag == 0)) && !var->nocopy)) {
 			OPC_BegStat();
 			if (var->typ->comp == 2) {
 				OPM_WriteString((CHAR*)"__DUPARR(", 10);
@@ -1593,11 +1599,11 @@ void OPC_EnterProc (OPT_Object proc)
 		OPM_Write('.');
 		OPM_WriteString((CHAR*)"lnk", 4);
 		OPM_WriteString((CHAR*)" = ", 4);
-		OPM_WriteStringVar((void*)scope->name, 256);
+		OPM_WriteStringVar((void*)scope->name->data, scope->name->len[0]);
 		OPM_WriteString((CHAR*)"_s", 3);
 		OPC_EndStat();
 		OPC_BegStat();
-		OPM_WriteStringVar((void*)scope->name, 256);
+		OPM_WriteStringVar((void*)scope->name->data, scope->name->len[0]);
 		OPM_WriteString((CHAR*)"_s", 3);
 		OPM_WriteString((CHAR*)" = ", 4);
 		OPM_Write('&');
@@ -1622,7 +1628,7 @@ void OPC_ExitProc (OPT_Object proc, BOOLEAN eoBlock, BOOLEAN implicitRet)
 			} else {
 				indent = 1;
 			}
-			OPM_WriteStringVar((void*)proc->scope->name, 256);
+			OPM_WriteStringVar((void*)proc->scope->name->data, proc->scope->name->len[0]);
 			OPM_WriteString((CHAR*)"_s", 3);
 			OPM_WriteString((CHAR*)" = ", 4);
 			OPM_WriteString((CHAR*)"_s", 3);
@@ -1632,7 +1638,7 @@ void OPC_ExitProc (OPT_Object proc, BOOLEAN eoBlock, BOOLEAN implicitRet)
 		}
 		var = proc->link;
 		while (var != NIL) {
-			if ((((var->typ->comp == 3 && var->mode == 1)) && var->typ->sysflag == 0)) {
+			if ((((((var->typ->comp == 3 && var->mode == 1)) && var->typ->sysflag == 0)) && !var->nocopy)) {
 				if (indent) {
 					OPC_BegStat();
 				} else {
@@ -1674,7 +1680,7 @@ void OPC_CompleteIdent (OPT_Object obj)
 		if ((obj->mode != 2 && comp != 3)) {
 			OPM_Write('*');
 		}
-		OPM_WriteStringVar((void*)obj->scope->name, 256);
+		OPM_WriteStringVar((void*)obj->scope->name->data, obj->scope->name->len[0]);
 		OPM_WriteString((CHAR*)"_s", 3);
 		OPM_WriteString((CHAR*)"->", 3);
 		OPC_Ident(obj);
@@ -1689,7 +1695,7 @@ void OPC_TypeOf (OPT_Object ap)
 	__ASSERT(ap->typ->comp == 4, 0);
 	if (ap->mode == 2) {
 		if ((INT16)ap->mnolev != OPM_level) {
-			OPM_WriteStringVar((void*)ap->scope->name, 256);
+			OPM_WriteStringVar((void*)ap->scope->name->data, ap->scope->name->len[0]);
 			OPM_WriteString((CHAR*)"_s->", 5);
 			OPC_Ident(ap);
 		} else {
@@ -1914,7 +1920,6 @@ void OPC_Constant (OPT_Const con, INT16 form)
 }
 
 static struct InitKeywords__46 {
-	INT8 *n;
 	struct InitKeywords__46 *lnk;
 } *InitKeywords__46_s;
 
@@ -1922,28 +1927,23 @@ static void Enter__47 (CHAR *s, ADDRESS s__len);
 
 static void Enter__47 (CHAR *s, ADDRESS s__len)
 {
+	OPS_Ident id = NIL;
 	INT16 h;
 	__DUP(s, s__len, CHAR);
-	h = OPC_PerfectHash((void*)s, s__len);
-	OPC_hashtab[__X(h, 105)] = *InitKeywords__46_s->n;
-	__COPY(s, OPC_keytab[__X(*InitKeywords__46_s->n, 50)], 9);
-	*InitKeywords__46_s->n += 1;
+	id = OPS_Intern(s, s__len);
+	h = OPC_KeySlot(id);
+	while (OPC_keytab[__X(h, 128)] != NIL) {
+		h = __MASK(h + 1, -128);
+	}
+	OPC_keytab[__X(h, 128)] = id;
 	__DEL(s);
 }
 
 static void OPC_InitKeywords (void)
 {
-	INT8 n, i;
 	struct InitKeywords__46 _s;
-	_s.n = &n;
 	_s.lnk = InitKeywords__46_s;
 	InitKeywords__46_s = &_s;
-	n = 0;
-	i = 0;
-	while (i <= 104) {
-		OPC_hashtab[__X(i, 105)] = -1;
-		i += 1;
-	}
 	Enter__47((CHAR*)"ADDRESS", 8);
 	Enter__47((CHAR*)"INT16", 6);
 	Enter__47((CHAR*)"INT32", 6);
@@ -1993,14 +1993,20 @@ static void OPC_InitKeywords (void)
 	InitKeywords__46_s = _s.lnk;
 }
 
+static void EnumPtrs(void (*P)(void*))
+{
+	__ENUMP(OPC_keytab, 128, P);
+}
+
 
 export void *OPC__init(void)
 {
 	__DEFMOD;
 	__MODULE_IMPORT(Configuration);
 	__MODULE_IMPORT(OPM);
+	__MODULE_IMPORT(OPS);
 	__MODULE_IMPORT(OPT);
-	__REGMOD("OPC", 0);
+	__REGMOD("OPC", EnumPtrs);
 	__REGCMD("BegBlk", OPC_BegBlk);
 	__REGCMD("BegStat", OPC_BegStat);
 	__REGCMD("EndBlk", OPC_EndBlk);
@@ -7,6 +7,13 @@
 
 #include "SYSTEM.h"
 #include "OPM.h"
+#include "Reals.h"
+
+typedef
+	struct {
+		ADDRESS len[1];
+		CHAR data[1];
+	} *OPS_Ident;
 
 typedef
 	CHAR OPS_Name[256];
@@ -16,17 +23,34 @@ typedef
 
 
 export OPS_Name OPS_name;
+export INT32 OPS_hash;
+export OPS_Ident OPS_ident;
 export OPS_String OPS_str;
 export INT16 OPS_numtyp;
 export INT64 OPS_intval;
 export REAL OPS_realval;
 export LONGREAL OPS_lrlval;
 static CHAR OPS_ch;
+static struct {
+	ADDRESS len[1];
+	OPS_Ident data[1];
+} *OPS_idents;
+static INT32 OPS_nofIdents;
+export INT32 OPS_nofTokens;
+static INT8 OPS_keySym[128];
+static INT32 OPS_keyHash[128];
+static CHAR OPS_keyName[128][10];
 
 
+static OPS_Ident OPS_Enter (CHAR *name, ADDRESS name__len, INT32 hash);
+static void OPS_EnterKeyword (CHAR *name, ADDRESS name__len, INT8 sym);
 export void OPS_Get (INT8 *sym);
+static void OPS_Grow (void);
+export INT32 OPS_HashOf (CHAR *name, ADDRESS name__len);
 static void OPS_Identifier (INT8 *sym);
 export void OPS_Init (void);
+export OPS_Ident OPS_Intern (CHAR *name, ADDRESS name__len);
+static INT16 OPS_KeySlot (INT32 hash);
 static void OPS_Number (void);
 static void OPS_Str (INT8 *sym);
 static void OPS_err (INT16 n);
@@ -71,21 +95,116 @@ static void OPS_Str (INT8 *sym)
 	}
 }
 
-static void OPS_Identifier (INT8 *sym)
+INT32 OPS_HashOf (CHAR *name, ADDRESS name__len)
 {
+	INT32 h;
 	INT16 i;
+	h = -2128831035;
 	i = 0;
+	while (name[__X(i, name__len)] != 0x00) {
+		h = (INT32)(((UINT32)h ^ (UINT32)name[__X(i, name__len)]) * 16777619);
+		i += 1;
+	}
+	return h;
+}
+
+static void OPS_Grow (void)
+{
+	INT32 i, j;
+	OPS_Ident id = NIL;
+	struct {
+		ADDRESS len[1];
+		OPS_Ident data[1];
+	} *old = NIL;
+	old = (void*)OPS_idents;
+	OPS_idents = __NEWARR(POINTER__typ, 4, 4, 1, 1, ((ADDRESS)(2 * old->len[0])));
+	i = 0;
+	while (i < old->len[0]) {
+		id = old->data[__X(i, old->len[0])];
+		if (id != NIL) {
+			j = __MASK(OPS_HashOf((void*)id->data, id->len[0]), -(INT32)OPS_idents->len[0]);
+			while (OPS_idents->data[__X(j, OPS_idents->len[0])] != NIL) {
+				j = __MASK(j + 1, -(INT32)OPS_idents->len[0]);
+			}
+			OPS_idents->data[__X(j, OPS_idents->len[0])] = id;
+		}
+		i += 1;
+	}
+}
+
+static OPS_Ident OPS_Enter (CHAR *name, ADDRESS name__len, INT32 hash)
+{
+	OPS_Ident id = NIL;
+	INT32 i, n;
+	if (2 * OPS_nofIdents >= OPS_idents->len[0]) {
+		OPS_Grow();
+	}
+	i = __MASK(hash, -(INT32)OPS_idents->len[0]);
+	id = OPS_idents->data[__X(i, OPS_idents->len[0])];
+	while (id != NIL) {
+		if (__STRCMP(id->data, name) == 0) {
+			return id;
+		}
+		i = __MASK(i + 1, -(INT32)OPS_idents->len[0]);
+		id = OPS_idents->data[__X(i, OPS_idents->len[0])];
+	}
+	n = 0;
+	while (name[__X(n, name__len)] != 0x00) {
+		n += 1;
+	}
+	id = __NEWARR(NIL, 1, 1, 1, 1, ((ADDRESS)(n + 1)));
+	__COPY(name, id->data, id->len[0]);
+	OPS_idents->data[__X(i, OPS_idents->len[0])] = id;
+	OPS_nofIdents += 1;
+	return id;
+}
+
+OPS_Ident OPS_Intern (CHAR *name, ADDRESS name__len)
+{
+	return OPS_Enter(name, name__len, OPS_HashOf(name, name__len));
+}
+
+static INT16 OPS_KeySlot (INT32 hash)
+{
+	return (INT16)__LSHR((UINT32)hash * 65, 25, 32);
+}
+
+static void OPS_EnterKeyword (CHAR *name, ADDRESS name__len, INT8 sym)
+{
+	INT32 h;
+	INT16 k;
+	h = OPS_HashOf((void*)name, name__len);
+	k = OPS_KeySlot(h);
+	OPS_keySym[__X(k, 128)] = sym;
+	OPS_keyHash[__X(k, 128)] = h;
+	__COPY(name, OPS_keyName[__X(k, 128)], 10);
+}
+
+static void OPS_Identifier (INT8 *sym)
+{
+	INT16 i, k;
+	i = 0;
+	OPS_hash = -2128831035;
 	do {
 		OPS_name[__X(i, 256)] = OPS_ch;
+		OPS_hash = (INT32)(((UINT32)OPS_hash ^ (UINT32)OPS_ch) * 16777619);
 		i += 1;
 		OPM_Get(&OPS_ch);
 	} while (!(((OPS_ch < '0' || ('9' < OPS_ch && __CAP(OPS_ch) < 'A')) || 'Z' < __CAP(OPS_ch)) || i == 256));
 	if (i == 256) {
 		OPS_err(240);
 		i -= 1;
+		OPS_name[__X(i, 256)] = 0x00;
+		OPS_hash = OPS_HashOf((void*)OPS_name, 256);
 	}
 	OPS_name[__X(i, 256)] = 0x00;
-	*sym = 38;
+	k = OPS_KeySlot(OPS_hash);
+	if (((OPS_keySym[__X(k, 128)] != 0 && OPS_keyHash[__X(k, 128)] == OPS_hash) && __STRCMP(OPS_keyName[__X(k, 128)], OPS_name) == 0)) {
+		*sym = OPS_keySym[__X(k, 128)];
+	} else {
+		OPS_ident = OPS_Enter((void*)OPS_name, 256, OPS_hash);
+		*sym = 38;
+	}
 }
 
 static struct Number__6 {
@@ -93,24 +212,6 @@ static struct Number__6 {
 } *Number__6_s;
 
 static INT16 Ord__7 (CHAR ch, BOOLEAN hex);
-static LONGREAL Ten__9 (INT16 e);
-
-static LONGREAL Ten__9 (INT16 e)
-{
-	LONGREAL x, p;
-	x = (LONGREAL)1;
-	p = (LONGREAL)10;
-	while (e > 0) {
-		if (__ODD(e)) {
-			x = x * p;
-		}
-		e = __ASHR(e, 1);
-		if (e > 0) {
-			p = p * p;
-		}
-	}
-	return x;
-}
 
 static INT16 Ord__7 (CHAR ch, BOOLEAN hex)
 {
@@ -127,9 +228,8 @@ static INT16 Ord__7 (CHAR ch, BOOLEAN hex)
 
 static void OPS_Number (void)
 {
-	INT16 i, m, n, d, e;
+	INT16 i, m, n, d, e, k;
 	CHAR dig[24];
-	LONGREAL f;
 	CHAR expCh;
 	BOOLEAN neg;
 	struct Number__6 _s;
@@ -209,12 +309,14 @@ static void OPS_Number (void)
 			OPS_err(203);
 		}
 	} else {
-		f = (LONGREAL)0;
 		e = 0;
 		expCh = 'E';
-		while (n > 0) {
-			n -= 1;
-			f = (Ord__7(dig[__X(n, 24)], 0) + f) / (LONGREAL)(LONGREAL)10;
+		k = 0;
+		while (k < n) {
+			if (dig[__X(k, 24)] > '9') {
+				OPS_err(2);
+			}
+			k += 1;
 		}
 		if (OPS_ch == 'E' || OPS_ch == 'D') {
 			expCh = OPS_ch;
@@ -228,10 +330,10 @@ static void OPS_Number (void)
 			}
 			if (('0' <= OPS_ch && OPS_ch <= '9')) {
 				do {
-					n = Ord__7(OPS_ch, 0);
+					k = Ord__7(OPS_ch, 0);
 					OPM_Get(&OPS_ch);
-					if (e <= __DIV(32767 - n, 10)) {
-						e = e * 10 + n;
+					if (e <= __DIV(32767 - k, 10)) {
+						e = e * 10 + k;
 					} else {
 						OPS_err(203);
 					}
@@ -247,22 +349,14 @@ static void OPS_Number (void)
 		if (expCh == 'E') {
 			OPS_numtyp = 3;
 			if ((-37 < e && e <= 38)) {
-				if (e < 0) {
-					OPS_realval = (f / (LONGREAL)Ten__9(-e));
-				} else {
-					OPS_realval = (f * Ten__9(e));
-				}
+				OPS_realval = Reals_Decimal((void*)dig, 24, n, e - n);
 			} else {
 				OPS_err(203);
 			}
 		} else {
 			OPS_numtyp = 4;
 			if ((-307 < e && e <= 308)) {
-				if (e < 0) {
-					OPS_lrlval = f / (LONGREAL)Ten__9(-e);
-				} else {
-					OPS_lrlval = f * Ten__9(e);
-				}
+				OPS_lrlval = Reals_DecimalL((void*)dig, 24, n, e - n);
 			} else {
 				OPS_err(203);
 			}
@@ -418,144 +512,12 @@ void OPS_Get (INT8 *sym)
 				s = 13;
 			}
 			break;
-		case 'A': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "ARRAY") == 0) {
-				s = 54;
-			}
-			break;
-		case 'B': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "BEGIN") == 0) {
-				s = 57;
-			} else if (__STRCMP(OPS_name, "BY") == 0) {
-				s = 29;
-			}
-			break;
-		case 'C': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "CASE") == 0) {
-				s = 46;
-			} else if (__STRCMP(OPS_name, "CONST") == 0) {
-				s = 58;
-			}
-			break;
-		case 'D': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "DO") == 0) {
-				s = 27;
-			} else if (__STRCMP(OPS_name, "DIV") == 0) {
-				s = 3;
-			}
-			break;
-		case 'E': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "END") == 0) {
-				s = 41;
-			} else if (__STRCMP(OPS_name, "ELSE") == 0) {
-				s = 42;
-			} else if (__STRCMP(OPS_name, "ELSIF") == 0) {
-				s = 43;
-			} else if (__STRCMP(OPS_name, "EXIT") == 0) {
-				s = 52;
-			}
-			break;
-		case 'F': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "FOR") == 0) {
-				s = 49;
-			}
-			break;
-		case 'I': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "IF") == 0) {
-				s = 45;
-			} else if (__STRCMP(OPS_name, "IN") == 0) {
-				s = 15;
-			} else if (__STRCMP(OPS_name, "IS") == 0) {
-				s = 16;
-			} else if (__STRCMP(OPS_name, "IMPORT") == 0) {
-				s = 62;
-			}
-			break;
-		case 'L': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "LOOP") == 0) {
-				s = 50;
-			}
-			break;
-		case 'M': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "MOD") == 0) {
-				s = 4;
-			} else if (__STRCMP(OPS_name, "MODULE") == 0) {
-				s = 63;
-			}
-			break;
-		case 'N': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "NIL") == 0) {
-				s = 36;
-			}
-			break;
-		case 'O': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "OR") == 0) {
-				s = 8;
-			} else if (__STRCMP(OPS_name, "OF") == 0) {
-				s = 25;
-			}
-			break;
-		case 'P': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "PROCEDURE") == 0) {
-				s = 61;
-			} else if (__STRCMP(OPS_name, "POINTER") == 0) {
-				s = 56;
-			}
-			break;
-		case 'R': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "RECORD") == 0) {
-				s = 55;
-			} else if (__STRCMP(OPS_name, "REPEAT") == 0) {
-				s = 48;
-			} else if (__STRCMP(OPS_name, "RETURN") == 0) {
-				s = 53;
-			}
-			break;
-		case 'T': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "THEN") == 0) {
-				s = 26;
-			} else if (__STRCMP(OPS_name, "TO") == 0) {
-				s = 28;
-			} else if (__STRCMP(OPS_name, "TYPE") == 0) {
-				s = 59;
-			}
-			break;
-		case 'U': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "UNTIL") == 0) {
-				s = 44;
-			}
-			break;
-		case 'V': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "VAR") == 0) {
-				s = 60;
-			}
-			break;
-		case 'W': 
-			OPS_Identifier(&s);
-			if (__STRCMP(OPS_name, "WHILE") == 0) {
-				s = 47;
-			} else if (__STRCMP(OPS_name, "WITH") == 0) {
-				s = 51;
-			}
-			break;
-		case 'G': case 'H': case 'J': case 'K': case 'Q': 
-		case 'S': case 'X': case 'Y': case 'Z': 
+		case 'A': case 'B': case 'C': case 'D': case 'E': 
+		case 'F': case 'G': case 'H': case 'I': case 'J': 
+		case 'K': case 'L': case 'M': case 'N': case 'O': 
+		case 'P': case 'Q': case 'R': case 'S': case 'T': 
+		case 'U': case 'V': case 'W': case 'X': case 'Y': 
+		case 'Z': 
 			OPS_Identifier(&s);
 			break;
 		case '[': 
@@ -603,6 +565,7 @@ void OPS_Get (INT8 *sym)
 			OPM_Get(&OPS_ch);
 			break;
 	}
+	OPS_nofTokens += 1;
 	*sym = s;
 	Get__1_s = _s.lnk;
 }
@@ -612,13 +575,55 @@ void OPS_Init (void)
 	OPS_ch = ' ';
 }
 
+static void EnumPtrs(void (*P)(void*))
+{
+	P(OPS_ident);
+	P(OPS_idents);
+}
+
 
 export void *OPS__init(void)
 {
 	__DEFMOD;
 	__MODULE_IMPORT(OPM);
-	__REGMOD("OPS", 0);
+	__MODULE_IMPORT(Reals);
+	__REGMOD("OPS", EnumPtrs);
 	__REGCMD("Init", OPS_Init);
 /* BEGIN */
+	OPS_idents = __NEWARR(POINTER__typ, 4, 4, 1, 1, ((ADDRESS)(4096)));
+	OPS_EnterKeyword((CHAR*)"ARRAY", 6, 54);
+	OPS_EnterKeyword((CHAR*)"BEGIN", 6, 57);
+	OPS_EnterKeyword((CHAR*)"BY", 3, 29);
+	OPS_EnterKeyword((CHAR*)"CASE", 5, 46);
+	OPS_EnterKeyword((CHAR*)"CONST", 6, 58);
+	OPS_EnterKeyword((CHAR*)"DIV", 4, 3);
+	OPS_EnterKeyword((CHAR*)"DO", 3, 27);
+	OPS_EnterKeyword((CHAR*)"ELSE", 5, 42);
+	OPS_EnterKeyword((CHAR*)"ELSIF", 6, 43);
+	OPS_EnterKeyword((CHAR*)"END", 4, 41);
+	OPS_EnterKeyword((CHAR*)"EXIT", 5, 52);
+	OPS_EnterKeyword((CHAR*)"FOR", 4, 49);
+	OPS_EnterKeyword((CHAR*)"IF", 3, 45);
+	OPS_EnterKeyword((CHAR*)"IMPORT", 7, 62);
+	OPS_EnterKeyword((CHAR*)"IN", 3, 15);
+	OPS_EnterKeyword((CHAR*)"IS", 3, 16);
+	OPS_EnterKeyword((CHAR*)"LOOP", 5, 50);
+	OPS_EnterKeyword((CHAR*)"MOD", 4, 4);
+	OPS_EnterKeyword((CHAR*)"MODULE", 7, 63);
+	OPS_EnterKeyword((CHAR*)"NIL", 4, 36);
+	OPS_EnterKeyword((CHAR*)"OF", 3, 25);
+	OPS_EnterKeyword((CHAR*)"OR", 3, 8);
+	OPS_EnterKeyword((CHAR*)"POINTER", 8, 56);
+	OPS_EnterKeyword((CHAR*)"PROCEDURE", 10, 61);
+	OPS_EnterKeyword((CHAR*)"RECORD", 7, 55);
+	OPS_EnterKeyword((CHAR*)"REPEAT", 7, 48);
+	OPS_EnterKeyword((CHAR*)"RETURN", 7, 53);
+	OPS_EnterKeyword((CHAR*)"THEN", 5, 26);
+	OPS_EnterKeyword((CHAR*)"TO", 3, 28);
+	OPS_EnterKeyword((CHAR*)"TYPE", 5, 59);
+	OPS_EnterKeyword((CHAR*)"UNTIL", 6, 44);
+	OPS_EnterKeyword((CHAR*)"VAR", 4, 60);
+	OPS_EnterKeyword((CHAR*)"WHILE", 6, 47);
+	OPS_EnterKeyword((CHAR*)"WITH", 5, 51);
 	__ENDMOD;
 }
@@ -7,6 +7,7 @@
 #include "OPT.h"
 
 
+import INT32 OPV_nofIndexChecks, OPV_nofRangeChecks, OPV_nofGuards, OPV_nofDivMods;
 
 
 import void OPV_AdrAndSize (OPT_Object topScope);
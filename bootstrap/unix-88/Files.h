@@ -4,6 +4,7 @@
 #define Files__h
 
 #include "SYSTEM.h"
+#include "Platform.h"
 
 typedef
 	struct Files_FileDesc *Files_File;
@@ -33,8 +34,10 @@ import void Files_ChangeDirectory (CHAR *path, ADDRESS path__len, INT16 *res);
 import void Files_Close (Files_File f);
 import void Files_Delete (CHAR *name, ADDRESS name__len, INT16 *res);
 import void Files_GetDate (Files_File f, INT32 *t, INT32 *d);
+import void Files_GetIdentity (Files_File f, Platform_FileIdentity *identity, ADDRESS *identity__typ);
 import void Files_GetName (Files_File f, CHAR *name, ADDRESS name__len);
 import INT32 Files_Length (Files_File f);
+import void Files_Map (Files_File f, INT64 *adr, INT16 *res);
 import Files_File Files_New (CHAR *name, ADDRESS name__len);
 import Files_File Files_Old (CHAR *name, ADDRESS name__len);
 import INT32 Files_Pos (Files_Rider *r, ADDRESS *r__typ);
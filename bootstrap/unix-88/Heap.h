@@ -50,6 +50,11 @@ import INT64 Heap_allocated;
 import INT64 Heap_heap;
 import INT64 Heap_heapsize, Heap_heapMinExpand;
 import INT16 Heap_FileCount;
+import INT64 Heap_regionsize;
+import INT32 Heap_collections;
+import INT64 Heap_highWater;
+import INT64 Heap_allocatedTotal, Heap_pauseTotal, Heap_pauseMax;
+import INT32 Heap_pauses[24];
 
 import ADDRESS *Heap_ModuleDesc__typ;
 import ADDRESS *Heap_CmdDesc__typ;
@@ -65,7 +70,10 @@ import SYSTEM_PTR Heap_NEWREC (INT64 tag);
 import void Heap_REGCMD (Heap_Module m, Heap_CmdName name, Heap_Command cmd);
 import SYSTEM_PTR Heap_REGMOD (Heap_ModuleName name, Heap_EnumProc enumPtrs);
 import void Heap_REGTYP (Heap_Module m, INT64 typ);
+import SYSTEM_PTR Heap_RegionBlk (INT64 size);
+import SYSTEM_PTR Heap_RegionRec (INT64 tag);
 import void Heap_RegisterFinalizer (SYSTEM_PTR obj, Heap_Finalizer finalize);
+import void Heap_ReleaseRegion (void);
 import void Heap_Unlock (void);
 import void *Heap__init(void);
 
@@ -11,6 +11,7 @@
 #include "Modules.h"
 #include "Out.h"
 #include "Platform.h"
+#include "Reals.h"
 #include "Strings.h"
 #include "Texts.h"
 #include "VT100.h"
@@ -18,8 +19,26 @@
 typedef
 	CHAR OPM_FileName[32];
 
+typedef
+	struct {
+		ADDRESS len[1];
+		CHAR data[1];
+	} *OPM_Buffer;
+
+typedef
+	struct OPM_SymFileDesc *OPM_SymFile;
+
+typedef
+	struct OPM_SymFileDesc {
+		OPM_FileName name;
+		Platform_FileIdentity identity;
+		INT64 adr;
+		INT32 len;
+		OPM_SymFile next;
+	} OPM_SymFileDesc;
+
 
-static CHAR OPM_SourceFileName[256];
+export CHAR OPM_SourceFileName[256];
 static CHAR OPM_GlobalModel[10];
 export CHAR OPM_Model[10];
 static INT16 OPM_GlobalAddressSize;
@@ -37,20 +56,36 @@ export CHAR OPM_modName[32];
 export CHAR OPM_objname[64];
 static INT32 OPM_ErrorLineStartPos, OPM_ErrorLineLimitPos, OPM_ErrorLineNumber, OPM_lasterrpos;
 static Texts_Reader OPM_inR;
+static struct {
+	ADDRESS len[1];
+	CHAR data[1];
+} *OPM_src;
+static INT32 OPM_srcpos;
 static Texts_Text OPM_Log, OPM_Errors;
-static Files_Rider OPM_oldSF, OPM_newSF;
-static Files_Rider OPM_R[3];
-static Files_File OPM_oldSFile, OPM_newSFile, OPM_HFile, OPM_BFile, OPM_HIFile;
+static OPM_SymFile OPM_symFiles, OPM_oldSF;
+static INT32 OPM_oldSFpos;
+static BOOLEAN OPM_oldSFeof;
+static Files_Rider OPM_newSF;
+static OPM_Buffer OPM_out[3];
+static INT32 OPM_outLen[3];
+static Files_File OPM_newSFile, OPM_BFile, OPM_HIFile;
 static INT16 OPM_S;
 export CHAR OPM_InstallDir[1024];
 export CHAR OPM_ResourceDir[1024];
+export INT16 OPM_Jobs;
+export CHAR OPM_Profile;
+export INT32 OPM_nofBytes, OPM_nofLines;
+export INT32 OPM_phaseWall[5], OPM_phaseCpu[5];
+static INT32 OPM_wallStart[5], OPM_cpuStart[5];
+
+export ADDRESS *OPM_SymFileDesc__typ;
 
 
-static void OPM_Append (Files_Rider *R, ADDRESS *R__typ, Files_File F);
 export void OPM_CloseFiles (void);
 export void OPM_CloseOldSym (void);
 export void OPM_DeleteObj (CHAR *modulename, ADDRESS modulename__len);
 export void OPM_DeleteSym (CHAR *modulename, ADDRESS modulename__len);
+static void OPM_Emit (Files_File F, INT16 i, CHAR *ext, ADDRESS ext__len);
 export void OPM_FPrint (INT32 *fp, INT64 val);
 export void OPM_FPrintLReal (INT32 *fp, LONGREAL val);
 export void OPM_FPrintReal (INT32 *fp, REAL val);
@@ -58,11 +93,15 @@ export void OPM_FPrintSet (INT32 *fp, UINT64 val);
 static void OPM_FindInstallDir (void);
 static void OPM_FindLine (Files_File f, Files_Rider *r, ADDRESS *r__typ, INT64 pos);
 static void OPM_FingerprintBytes (INT32 *fp, SYSTEM_BYTE *bytes, ADDRESS bytes__len);
+static void OPM_ForgetSym (CHAR *fileName, ADDRESS fileName__len);
 export void OPM_Get (CHAR *ch);
+static void OPM_Grow (INT32 n);
 export void OPM_Init (BOOLEAN *done);
 export void OPM_InitOptions (void);
 export INT16 OPM_Integer (INT64 n);
 static BOOLEAN OPM_IsProbablyInstallDir (CHAR *s, ADDRESS s__len);
+static BOOLEAN OPM_LoadSource (CHAR *name, ADDRESS name__len);
+static OPM_SymFile OPM_LoadSym (CHAR *fileName, ADDRESS fileName__len);
 export void OPM_LogCompiling (CHAR *modname, ADDRESS modname__len);
 static void OPM_LogErrMsg (INT16 n);
 export void OPM_LogVT100 (CHAR *vt100code, ADDRESS vt100code__len);
@@ -74,26 +113,50 @@ export INT32 OPM_Longint (INT64 n);
 static void OPM_MakeFileName (CHAR *name, ADDRESS name__len, CHAR *FName, ADDRESS FName__len, CHAR *ext, ADDRESS ext__len);
 export void OPM_Mark (INT16 n, INT32 pos);
 export void OPM_NewSym (CHAR *modName, ADDRESS modName__len);
-export void OPM_OldSym (CHAR *modName, ADDRESS modName__len, BOOLEAN *done);
-export void OPM_OpenFiles (CHAR *moduleName, ADDRESS moduleName__len);
+export void OPM_OldSym (CHAR *modName, ADDRESS modName__len, OPM_SymFile *sf);
+export void OPM_StartPhase (INT16 p)
+{
+	OPM_wallStart[__X(p, 5)] = Platform_Time();
+	OPM_cpuStart[__X(p, 5)] = Platform_CpuTime();
+}
+
+void OPM_StopPhase (INT16 p)
+{
+	OPM_phaseWall[__X(p, 5)] += Platform_Time() - OPM_wallStart[__X(p, 5)];
+	OPM_phaseCpu[__X(p, 5)] += Platform_CpuTime() - OPM_cpuStart[__X(p, 5)];
+}
+
+void OPM_OpenFiles (CHAR *moduleName, ADDRESS moduleName__len);
 export BOOLEAN OPM_OpenPar (void);
 export void OPM_RegisterNewSym (void);
 static void OPM_ScanOptions (CHAR *s, ADDRESS s__len);
 static void OPM_ShowLine (INT64 pos);
 export INT64 OPM_SignedMaximum (INT32 bytecount);
 export INT64 OPM_SignedMinimum (INT32 bytecount);
+export void OPM_StartPhase (INT16 p);
+export void OPM_StopPhase (INT16 p);
+export INT32 OPM_SymPos (void);
+static void OPM_SymRBytes (SYSTEM_BYTE *x, ADDRESS x__len);
 export void OPM_SymRCh (CHAR *ch);
 export INT32 OPM_SymRInt (void);
 export INT64 OPM_SymRInt64 (void);
+export INT32 OPM_SymRLInt (void);
 export void OPM_SymRLReal (LONGREAL *lr);
 export void OPM_SymRReal (REAL *r);
 export void OPM_SymRSet (UINT64 *s);
+export void OPM_SymSelect (OPM_SymFile sf, INT32 pos);
+export void OPM_SymStamp (OPM_SymFile sf, Platform_FileIdentity *identity, ADDRESS *identity__typ, INT32 *len);
+static void OPM_SymWBytes (SYSTEM_BYTE *x, ADDRESS x__len);
 export void OPM_SymWCh (CHAR ch);
 export void OPM_SymWInt (INT64 i);
+export void OPM_SymWLInt (INT32 i);
 export void OPM_SymWLReal (LONGREAL lr);
+export INT32 OPM_SymWPos (void);
 export void OPM_SymWReal (REAL r);
 export void OPM_SymWSet (UINT64 s);
+export void OPM_SymWSetPos (INT32 pos);
 export void OPM_Write (CHAR ch);
+static void OPM_WriteBuffer (Files_Rider *R, ADDRESS *R__typ, INT16 i);
 export void OPM_WriteHex (INT64 i);
 export void OPM_WriteInt (INT64 i);
 export void OPM_WriteLn (void);
@@ -229,6 +292,18 @@ static void OPM_ScanOptions (CHAR *s, ADDRESS s__len)
 			case 'V': 
 				OPM_Options = OPM_Options ^ 0x040000;
 				break;
+			case 'i': 
+				OPM_Options = OPM_Options ^ 0x080000;
+				break;
+			case 'U': 
+				OPM_Options = OPM_Options ^ 0x100000;
+				break;
+			case 'T': 
+				OPM_Options = OPM_Options ^ 0x200000;
+				break;
+			case 'o': 
+				OPM_Options = OPM_Options ^ 0x400000;
+				break;
 			case 'O': 
 				if (i + 1 >= Strings_Length(s, s__len)) {
 					OPM_LogWStr((CHAR*)"-O option requires following size model character.", 51);
@@ -243,6 +318,34 @@ static void OPM_ScanOptions (CHAR *s, ADDRESS s__len)
 					i += 1;
 				}
 				break;
+			case 'j': 
+				if (i + 1 >= Strings_Length(s, s__len)) {
+					OPM_LogWStr((CHAR*)"-j option requires following job count digit.", 46);
+					OPM_LogWLn();
+				} else {
+					OPM_Jobs = (INT16)s[__X(i + 1, s__len)] - 48;
+					if (OPM_Jobs < 1 || OPM_Jobs > 9) {
+						OPM_LogWStr((CHAR*)"Job count following -j must be a digit from 1 to 9.", 52);
+						OPM_LogWLn();
+						OPM_Jobs = 1;
+					}
+					i += 1;
+				}
+				break;
+			case 'P': 
+				if (i + 1 >= Strings_Length(s, s__len)) {
+					OPM_LogWStr((CHAR*)"-P option requires following build profile character.", 54);
+					OPM_LogWLn();
+				} else {
+					OPM_Profile = s[__X(i + 1, s__len)];
+					if ((((((OPM_Profile != 'd' && OPM_Profile != 'r')) && OPM_Profile != 'l')) && OPM_Profile != 'p')) {
+						OPM_LogWStr((CHAR*)"Unrecognised build profile character following -P.", 51);
+						OPM_LogWLn();
+						OPM_Profile = 'd';
+					}
+					i += 1;
+				}
+				break;
 			case 'A': 
 				if (i + 2 >= Strings_Length(s, s__len)) {
 					OPM_LogWStr((CHAR*)"-M option requires two following digits.", 41);
@@ -287,7 +390,7 @@ BOOLEAN OPM_OpenPar (void)
 		OPM_LogWLn();
 		OPM_LogWLn();
 		OPM_LogWStr((CHAR*)"  ", 3);
-		OPM_LogWStr((CHAR*)"scream", 4);
+		OPM_LogWStr((CHAR*)"scream", 7);
 		OPM_LogWStr((CHAR*)" options {files {options}}.", 28);
 		OPM_LogWLn();
 		OPM_LogWLn();
@@ -326,13 +429,31 @@ BOOLEAN OPM_OpenPar (void)
 		OPM_LogWLn();
 		OPM_LogWStr((CHAR*)"    -c   Don't link.", 21);
 		OPM_LogWLn();
+		OPM_LogWStr((CHAR*)"    -jN  Run up to N C compiler processes in parallel (default 4).", 67);
+		OPM_LogWLn();
+		OPM_LogWStr((CHAR*)"    -i   Incremental. Skip modules whose source, options and imports are unchanged.", 84);
+		OPM_LogWLn();
+		OPM_LogWStr((CHAR*)"    -U   Unity build. Compile the main module with all modules of this run as one C file.", 90);
+		OPM_LogWLn();
+		OPM_LogWStr((CHAR*)"    -o   Optimise. Propagate constants and copies and drop index and guard checks already made.", 96);
+		OPM_LogWLn();
+		OPM_LogWStr((CHAR*)"    -Px  Build profile: d debug (default), r release (-O2), l release with link time optimisation,", 99);
+		OPM_LogWLn();
+		OPM_LogWStr((CHAR*)"         p profile guided: build instrumented, run $PGOTRAIN (default ./Main), rebuild optimised.", 98);
+		OPM_LogWLn();
 		OPM_LogWLn();
 		OPM_LogWStr((CHAR*)"  Miscellaneous", 16);
 		OPM_LogWLn();
+		OPM_LogWStr((CHAR*)"    -T   Record time per phase and module and compiler statistics in build-stats.json.", 87);
+		OPM_LogWLn();
 		OPM_LogWStr((CHAR*)"    -f   Disable VT100 control characters in status output.", 60);
 		OPM_LogWLn();
 		OPM_LogWStr((CHAR*)"    -V   Display compiler debugging messages.", 46);
 		OPM_LogWLn();
+		OPM_LogWStr((CHAR*)"    -D s Serve compiles on Unix socket s, keeping imported symbol files loaded. First option only.", 99);
+		OPM_LogWLn();
+		OPM_LogWStr((CHAR*)"    -C s Compile the remaining arguments through the server on socket s. First option only.", 92);
+		OPM_LogWLn();
 		OPM_LogWLn();
 		OPM_LogWStr((CHAR*)"  Size model for elementary types (default O2)", 47);
 		OPM_LogWLn();
@@ -366,6 +487,8 @@ BOOLEAN OPM_OpenPar (void)
 		OPM_GetAlignment(&OPM_Alignment);
 		__MOVE("2", OPM_Model, 2);
 		OPM_Options = 0xa9;
+		OPM_Jobs = 4;
+		OPM_Profile = 'd';
 		OPM_S = 1;
 		s[0] = 0x00;
 		Modules_GetArg(OPM_S, (void*)s, 256);
@@ -448,6 +571,41 @@ void OPM_InitOptions (void)
 	Files_SetSearchPath(searchpath, 1024);
 }
 
+static BOOLEAN OPM_LoadSource (CHAR *name, ADDRESS name__len)
+{
+	Files_File f = NIL;
+	Files_Rider r;
+	CHAR tag, version;
+	INT32 len, i;
+	OPM_src = NIL;
+	OPM_srcpos = 0;
+	f = Files_Old(name, name__len);
+	if (f == NIL) {
+		return 0;
+	}
+	len = Files_Length(f);
+	Files_Set(&r, Files_Rider__typ, f, 0);
+	Files_Read(&r, Files_Rider__typ, (void*)&tag);
+	Files_Read(&r, Files_Rider__typ, (void*)&version);
+	if ((((len == 0 || tag == 0xf0) || (tag == 0x01 && version == 0xf0)) || (tag == 0xf7 && version == 0x07))) {
+		Files_Close(f);
+		return 0;
+	}
+	OPM_src = __NEWARR(NIL, 1, 1, 1, 1, ((ADDRESS)(len)));
+	Files_Set(&r, Files_Rider__typ, f, 0);
+	Files_ReadBytes(&r, Files_Rider__typ, (void*)OPM_src->data, OPM_src->len[0], len);
+	Files_Close(f);
+	OPM_nofLines = 1;
+	i = 0;
+	while (i < len) {
+		if (OPM_src->data[__X(i, OPM_src->len[0])] == 0x0a) {
+			OPM_nofLines += 1;
+		}
+		i += 1;
+	}
+	return 1;
+}
+
 void OPM_Init (BOOLEAN *done)
 {
 	Texts_Text T = NIL;
@@ -460,18 +618,22 @@ void OPM_Init (BOOLEAN *done)
 	}
 	s[0] = 0x00;
 	Modules_GetArg(OPM_S, (void*)s, 256);
-	__NEW(T, Texts_TextDesc);
-	Texts_Open(T, s, 256);
 	OPM_LogWStr(s, 256);
 	OPM_LogWStr((CHAR*)"  ", 3);
 	__COPY(s, OPM_SourceFileName, 256);
-	if (T->len == 0) {
-		OPM_LogWStr(s, 256);
-		OPM_LogWStr((CHAR*)" not found.", 12);
-		OPM_LogWLn();
-	} else {
-		Texts_OpenReader(&OPM_inR, Texts_Reader__typ, T, 0);
+	if (OPM_LoadSource(s, 256)) {
 		*done = 1;
+	} else {
+		__NEW(T, Texts_TextDesc);
+		Texts_Open(T, s, 256);
+		if (T->len == 0) {
+			OPM_LogWStr(s, 256);
+			OPM_LogWStr((CHAR*)" not found.", 12);
+			OPM_LogWLn();
+		} else {
+			Texts_OpenReader(&OPM_inR, Texts_Reader__typ, T, 0);
+			*done = 1;
+		}
 	}
 	OPM_S += 1;
 	OPM_level = 0;
@@ -485,10 +647,30 @@ void OPM_Init (BOOLEAN *done)
 
 void OPM_Get (CHAR *ch)
 {
-	OPM_curpos = Texts_Pos(&OPM_inR, Texts_Reader__typ);
-	Texts_Read(&OPM_inR, Texts_Reader__typ, &*ch);
-	if ((*ch < 0x09 && !OPM_inR.eot)) {
-		*ch = ' ';
+	if (OPM_src != NIL) {
+		OPM_curpos = OPM_srcpos;
+		if (OPM_srcpos < OPM_src->len[0]) {
+			*ch = (OPM_src->data)[__X(OPM_srcpos, OPM_src->len[0])];
+			OPM_srcpos += 1;
+			if (*ch == 0x0a) {
+				*ch = 0x0d;
+			} else if (*ch == 0x0d) {
+				if ((OPM_srcpos < OPM_src->len[0] && (OPM_src->data)[__X(OPM_srcpos, OPM_src->len[0])] == 0x0a)) {
+					OPM_srcpos += 1;
+				}
+			} else if (*ch < 0x09) {
+				*ch = ' ';
+			}
+		} else {
+			*ch = 0x00;
+			OPM_srcpos += 1;
+		}
+	} else {
+		OPM_curpos = Texts_Pos(&OPM_inR, Texts_Reader__typ);
+		Texts_Read(&OPM_inR, Texts_Reader__typ, &*ch);
+		if ((*ch < 0x09 && !OPM_inR.eot)) {
+			*ch = ' ';
+		}
 	}
 }
 
@@ -710,72 +892,186 @@ void OPM_FPrintLReal (INT32 *fp, LONGREAL val)
 	OPM_FingerprintBytes(&*fp, (void*)&val, 8);
 }
 
+static OPM_SymFile OPM_LoadSym (CHAR *fileName, ADDRESS fileName__len)
+{
+	Files_File f = NIL;
+	Platform_FileIdentity identity;
+	OPM_SymFile sf = NIL;
+	INT32 len;
+	INT64 adr;
+	INT16 res;
+	f = Files_Old(fileName, fileName__len);
+	if (f == NIL) {
+		return NIL;
+	}
+	Files_GetIdentity(f, &identity, Platform_FileIdentity__typ);
+	len = Files_Length(f);
+	sf = OPM_symFiles;
+	while ((sf != NIL && __STRCMP(sf->name, fileName) != 0)) {
+		sf = sf->next;
+	}
+	if (sf == NIL) {
+		__NEW(sf, OPM_SymFileDesc);
+		__COPY(fileName, sf->name, 32);
+		sf->next = OPM_symFiles;
+		OPM_symFiles = sf;
+	} else if ((((Platform_SameFile(sf->identity, identity) && Platform_SameFileTime(sf->identity, identity))) && sf->len == len)) {
+		return sf;
+	} else if (sf->adr != 0) {
+		res = Platform_UnmapFile(sf->adr, sf->len);
+		sf->adr = 0;
+	}
+	adr = 0;
+	if (len > 0) {
+		Files_Map(f, &adr, &res);
+	}
+	Files_Close(f);
+	if (adr == 0) {
+		OPM_ForgetSym(fileName, fileName__len);
+		return NIL;
+	}
+	sf->identity = identity;
+	sf->adr = adr;
+	sf->len = len;
+	return sf;
+}
+
+static void OPM_ForgetSym (CHAR *fileName, ADDRESS fileName__len)
+{
+	OPM_SymFile sf = NIL, prev = NIL;
+	INT16 res;
+	sf = OPM_symFiles;
+	while ((sf != NIL && __STRCMP(sf->name, fileName) != 0)) {
+		prev = sf;
+		sf = sf->next;
+	}
+	if (sf != NIL) {
+		if (prev == NIL) {
+			OPM_symFiles = sf->next;
+		} else {
+			prev->next = sf->next;
+		}
+		if (sf->adr != 0) {
+			res = Platform_UnmapFile(sf->adr, sf->len);
+			sf->adr = 0;
+		}
+	}
+}
+
 void OPM_SymRCh (CHAR *ch)
 {
-	Files_Read(&OPM_oldSF, Files_Rider__typ, (void*)&*ch);
+	if (OPM_oldSFpos < OPM_oldSF->len) {
+		__GET(OPM_oldSF->adr + OPM_oldSFpos, *ch, CHAR);
+		OPM_oldSFpos += 1;
+	} else {
+		*ch = 0x00;
+		OPM_oldSFeof = 1;
+	}
 }
 
-INT32 OPM_SymRInt (void)
+static void OPM_SymRBytes (SYSTEM_BYTE *x, ADDRESS x__len)
 {
-	INT32 k;
-	Files_ReadNum(&OPM_oldSF, Files_Rider__typ, (void*)&k, 4);
-	return k;
+	INT32 i;
+	i = 0;
+	while (i < x__len) {
+		if (Platform_LittleEndian) {
+			OPM_SymRCh((void*)&x[__X(i, x__len)]);
+		} else {
+			OPM_SymRCh((void*)&x[__X((x__len - 1) - i, x__len)]);
+		}
+		i += 1;
+	}
 }
 
 INT64 OPM_SymRInt64 (void)
 {
-	INT64 k;
-	Files_ReadNum(&OPM_oldSF, Files_Rider__typ, (void*)&k, 8);
-	return k;
+	INT8 s, b;
+	INT64 q;
+	s = 0;
+	q = 0;
+	OPM_SymRCh((void*)&b);
+	while (b < 0) {
+		q += (INT64)__ASH(((INT16)b + 128), s);
+		s += 7;
+		OPM_SymRCh((void*)&b);
+	}
+	q += (INT64)__ASH((__MASK(b, -64) - __ASHL(__ASHR(b, 6), 6)), s);
+	return q;
+}
+
+INT32 OPM_SymRInt (void)
+{
+	return (INT32)OPM_SymRInt64();
+}
+
+INT32 OPM_SymRLInt (void)
+{
+	INT32 x;
+	OPM_SymRBytes((void*)&x, 4);
+	return x;
+}
+
+INT32 OPM_SymPos (void)
+{
+	return OPM_oldSFpos;
+}
+
+void OPM_SymSelect (OPM_SymFile sf, INT32 pos)
+{
+	OPM_oldSF = sf;
+	OPM_oldSFpos = pos;
+	OPM_oldSFeof = 0;
+}
+
+void OPM_SymStamp (OPM_SymFile sf, Platform_FileIdentity *identity, ADDRESS *identity__typ, INT32 *len)
+{
+	*identity = sf->identity;
+	*len = sf->len;
 }
 
 void OPM_SymRSet (UINT64 *s)
 {
-	Files_ReadNum(&OPM_oldSF, Files_Rider__typ, (void*)&*s, 8);
+	*s = (UINT64)OPM_SymRInt64();
 }
 
 void OPM_SymRReal (REAL *r)
 {
-	Files_ReadReal(&OPM_oldSF, Files_Rider__typ, &*r);
+	OPM_SymRBytes((void*)&*r, 4);
 }
 
 void OPM_SymRLReal (LONGREAL *lr)
 {
-	Files_ReadLReal(&OPM_oldSF, Files_Rider__typ, &*lr);
+	OPM_SymRBytes((void*)&*lr, 8);
 }
 
 void OPM_CloseOldSym (void)
 {
-	Files_Close(Files_Base(&OPM_oldSF, Files_Rider__typ));
+	OPM_oldSF = NIL;
 }
 
-void OPM_OldSym (CHAR *modName, ADDRESS modName__len, BOOLEAN *done)
+void OPM_OldSym (CHAR *modName, ADDRESS modName__len, OPM_SymFile *sf)
 {
 	CHAR tag, ver;
 	OPM_FileName fileName;
-	INT16 res;
-	OPM_oldSFile = NIL;
-	*done = 0;
 	OPM_MakeFileName((void*)modName, modName__len, (void*)fileName, 32, (CHAR*)".sym", 5);
-	OPM_oldSFile = Files_Old(fileName, 32);
-	*done = OPM_oldSFile != NIL;
-	if (*done) {
-		Files_Set(&OPM_oldSF, Files_Rider__typ, OPM_oldSFile, 0);
-		Files_Read(&OPM_oldSF, Files_Rider__typ, (void*)&tag);
-		Files_Read(&OPM_oldSF, Files_Rider__typ, (void*)&ver);
-		if (tag != 0xf7 || ver != 0x83) {
+	*sf = OPM_LoadSym((void*)fileName, 32);
+	OPM_SymSelect(*sf, 0);
+	if (*sf != NIL) {
+		OPM_SymRCh(&tag);
+		OPM_SymRCh(&ver);
+		if (tag != 0xf7 || ver != 0x84) {
 			if (!__IN(4, OPM_Options, 32)) {
 				OPM_err(-306);
 			}
 			OPM_CloseOldSym();
-			*done = 0;
+			*sf = NIL;
 		}
 	}
 }
 
 BOOLEAN OPM_eofSF (void)
 {
-	return OPM_oldSF.eof;
+	return OPM_oldSFeof;
 }
 
 void OPM_SymWCh (CHAR ch)
@@ -788,6 +1084,25 @@ void OPM_SymWInt (INT64 i)
 	Files_WriteNum(&OPM_newSF, Files_Rider__typ, i);
 }
 
+static void OPM_SymWBytes (SYSTEM_BYTE *x, ADDRESS x__len)
+{
+	INT32 i;
+	i = 0;
+	while (i < x__len) {
+		if (Platform_LittleEndian) {
+			Files_Write(&OPM_newSF, Files_Rider__typ, x[__X(i, x__len)]);
+		} else {
+			Files_Write(&OPM_newSF, Files_Rider__typ, x[__X((x__len - 1) - i, x__len)]);
+		}
+		i += 1;
+	}
+}
+
+void OPM_SymWLInt (INT32 i)
+{
+	OPM_SymWBytes((void*)&i, 4);
+}
+
 void OPM_SymWSet (UINT64 s)
 {
 	Files_WriteNum(&OPM_newSF, Files_Rider__typ, (INT64)s);
@@ -803,9 +1118,22 @@ void OPM_SymWLReal (LONGREAL lr)
 	Files_WriteLReal(&OPM_newSF, Files_Rider__typ, lr);
 }
 
+INT32 OPM_SymWPos (void)
+{
+	return Files_Pos(&OPM_newSF, Files_Rider__typ);
+}
+
+void OPM_SymWSetPos (INT32 pos)
+{
+	Files_Set(&OPM_newSF, Files_Rider__typ, OPM_newSFile, pos);
+}
+
 void OPM_RegisterNewSym (void)
 {
+	OPM_FileName fn;
 	if (__STRCMP(OPM_modName, "SYSTEM") != 0 || __IN(10, OPM_Options, 32)) {
+		OPM_MakeFileName((void*)OPM_modName, 32, (void*)fn, 32, (CHAR*)".sym", 5);
+		OPM_ForgetSym((void*)fn, 32);
 		Files_Register(OPM_newSFile);
 	}
 }
@@ -815,6 +1143,7 @@ void OPM_DeleteSym (CHAR *modulename, ADDRESS modulename__len)
 	OPM_FileName fn;
 	INT16 res;
 	OPM_MakeFileName((void*)modulename, modulename__len, (void*)fn, 32, (CHAR*)".sym", 5);
+	OPM_ForgetSym((void*)fn, 32);
 	Files_Delete(fn, 32, &res);
 }
 
@@ -834,15 +1163,32 @@ void OPM_NewSym (CHAR *modName, ADDRESS modName__len)
 	if (OPM_newSFile != NIL) {
 		Files_Set(&OPM_newSF, Files_Rider__typ, OPM_newSFile, 0);
 		Files_Write(&OPM_newSF, Files_Rider__typ, 0xf7);
-		Files_Write(&OPM_newSF, Files_Rider__typ, 0x83);
+		Files_Write(&OPM_newSF, Files_Rider__typ, 0x84);
 	} else {
 		OPM_err(153);
 	}
 }
 
+static void OPM_Grow (INT32 n)
+{
+	OPM_Buffer b = NIL;
+	INT32 size;
+	size = OPM_out[__X(OPM_currFile, 3)]->len[0];
+	while (OPM_outLen[__X(OPM_currFile, 3)] + n > size) {
+		size = 2 * size;
+	}
+	b = __NEWARR(NIL, 1, 1, 1, 1, ((ADDRESS)(size)));
+	__MOVE((ADDRESS)OPM_out[__X(OPM_currFile, 3)]->data, (ADDRESS)b->data, OPM_outLen[__X(OPM_currFile, 3)]);
+	OPM_out[__X(OPM_currFile, 3)] = b;
+}
+
 void OPM_Write (CHAR ch)
 {
-	Files_Write(&OPM_R[__X(OPM_currFile, 3)], Files_Rider__typ, ch);
+	if (OPM_outLen[__X(OPM_currFile, 3)] >= OPM_out[__X(OPM_currFile, 3)]->len[0]) {
+		OPM_Grow(1);
+	}
+	OPM_out[__X(OPM_currFile, 3)]->data[__X(OPM_outLen[__X(OPM_currFile, 3)], OPM_out[__X(OPM_currFile, 3)]->len[0])] = ch;
+	OPM_outLen[__X(OPM_currFile, 3)] += 1;
 }
 
 void OPM_WriteString (CHAR *s, ADDRESS s__len)
@@ -852,7 +1198,11 @@ void OPM_WriteString (CHAR *s, ADDRESS s__len)
 	while (s[__X(i, s__len)] != 0x00) {
 		i += 1;
 	}
-	Files_WriteBytes(&OPM_R[__X(OPM_currFile, 3)], Files_Rider__typ, (void*)s, s__len * 1, i);
+	if (OPM_outLen[__X(OPM_currFile, 3)] + i > OPM_out[__X(OPM_currFile, 3)]->len[0]) {
+		OPM_Grow(i);
+	}
+	__MOVE((ADDRESS)s, (ADDRESS)&OPM_out[__X(OPM_currFile, 3)]->data[__X(OPM_outLen[__X(OPM_currFile, 3)], OPM_out[__X(OPM_currFile, 3)]->len[0])], i);
+	OPM_outLen[__X(OPM_currFile, 3)] += i;
 }
 
 void OPM_WriteStringVar (CHAR *s, ADDRESS s__len)
@@ -862,7 +1212,11 @@ void OPM_WriteStringVar (CHAR *s, ADDRESS s__len)
 	while (s[__X(i, s__len)] != 0x00) {
 		i += 1;
 	}
-	Files_WriteBytes(&OPM_R[__X(OPM_currFile, 3)], Files_Rider__typ, (void*)s, s__len * 1, i);
+	if (OPM_outLen[__X(OPM_currFile, 3)] + i > OPM_out[__X(OPM_currFile, 3)]->len[0]) {
+		OPM_Grow(i);
+	}
+	__MOVE((ADDRESS)s, (ADDRESS)&OPM_out[__X(OPM_currFile, 3)]->data[__X(OPM_outLen[__X(OPM_currFile, 3)], OPM_out[__X(OPM_currFile, 3)]->len[0])], i);
+	OPM_outLen[__X(OPM_currFile, 3)] += i;
 }
 
 void OPM_WriteHex (INT64 i)
@@ -922,12 +1276,8 @@ void OPM_WriteInt (INT64 i)
 
 void OPM_WriteReal (LONGREAL r, CHAR suffx)
 {
-	Texts_Writer W;
-	Texts_Text T = NIL;
-	Texts_Reader R;
-	CHAR s[32];
-	CHAR ch;
-	INT16 i;
+	CHAR d[17];
+	INT16 n, e, i;
 	if ((((r < OPM_SignedMaximum(OPM_LongintSize) && r > OPM_SignedMinimum(OPM_LongintSize))) && r == (__SHORT(__ENTIER(r), 2147483648LL)))) {
 		if (suffx == 'f') {
 			OPM_WriteString((CHAR*)"(REAL)", 7);
@@ -936,118 +1286,152 @@ void OPM_WriteReal (LONGREAL r, CHAR suffx)
 		}
 		OPM_WriteInt(__SHORT(__ENTIER(r), 2147483648LL));
 	} else {
-		Texts_OpenWriter(&W, Texts_Writer__typ);
+		if (r < (LONGREAL)0) {
+			OPM_Write('-');
+		}
 		if (suffx == 'f') {
-			Texts_WriteLongReal(&W, Texts_Writer__typ, r, 16);
+			n = Reals_Digits((REAL)r, 0, (void*)d, 17, &e);
 		} else {
-			Texts_WriteLongReal(&W, Texts_Writer__typ, r, 23);
+			n = Reals_DigitsL(r, 0, (void*)d, 17, &e);
 		}
-		__NEW(T, Texts_TextDesc);
-		Texts_Open(T, (CHAR*)"", 1);
-		Texts_Append(T, W.buf);
-		Texts_OpenReader(&R, Texts_Reader__typ, T, 0);
-		i = 0;
-		Texts_Read(&R, Texts_Reader__typ, &ch);
-		while (ch != 0x00) {
-			s[__X(i, 32)] = ch;
-			i += 1;
-			Texts_Read(&R, Texts_Reader__typ, &ch);
+		OPM_Write(d[0]);
+		OPM_Write('.');
+		if (n == 1) {
+			OPM_Write('0');
 		}
-		s[__X(i, 32)] = 0x00;
-		i = 0;
-		ch = s[0];
-		while ((ch != 'D' && ch != 0x00)) {
+		i = 1;
+		while (i < n) {
+			OPM_Write(d[__X(i, 17)]);
 			i += 1;
-			ch = s[__X(i, 32)];
 		}
-		if (ch == 'D') {
-			s[__X(i, 32)] = 'e';
+		OPM_Write('e');
+		if (e < 0) {
+			OPM_Write('-');
+			e = -e;
+		} else {
+			OPM_Write('+');
 		}
-		OPM_WriteString(s, 32);
+		OPM_Write(__CHR(__DIV(e, 100) + 48));
+		e = (int)__MOD(e, 100);
+		OPM_Write(__CHR(__DIV(e, 10) + 48));
+		OPM_Write(__CHR((int)__MOD(e, 10) + 48));
 	}
 }
 
 void OPM_WriteLn (void)
 {
-	Files_Write(&OPM_R[__X(OPM_currFile, 3)], Files_Rider__typ, 0x0a);
+	OPM_Write(0x0a);
 }
 
-static void OPM_Append (Files_Rider *R, ADDRESS *R__typ, Files_File F)
+static void OPM_WriteBuffer (Files_Rider *R, ADDRESS *R__typ, INT16 i)
 {
-	Files_Rider R1;
-	CHAR buffer[4096];
-	if (F != NIL) {
-		Files_Set(&R1, Files_Rider__typ, F, 0);
-		Files_ReadBytes(&R1, Files_Rider__typ, (void*)buffer, 4096, 4096);
-		while (4096 - R1.res > 0) {
-			Files_WriteBytes(&*R, R__typ, (void*)buffer, 4096, 4096 - R1.res);
-			Files_ReadBytes(&R1, Files_Rider__typ, (void*)buffer, 4096, 4096);
-		}
-	}
+	Files_WriteBytes(&*R, R__typ, (void*)OPM_out[__X(i, 3)]->data, OPM_out[__X(i, 3)]->len[0] * 1, OPM_outLen[__X(i, 3)]);
 }
 
 void OPM_OpenFiles (CHAR *moduleName, ADDRESS moduleName__len)
 {
 	OPM_FileName FName;
 	__COPY(moduleName, OPM_modName, 32);
-	OPM_HFile = Files_New((CHAR*)"", 1);
-	if (OPM_HFile != NIL) {
-		Files_Set(&OPM_R[0], Files_Rider__typ, OPM_HFile, 0);
-	} else {
-		OPM_err(153);
+	if (OPM_out[0] == NIL) {
+		OPM_out[0] = __NEWARR(NIL, 1, 1, 1, 1, ((ADDRESS)(16384)));
+		OPM_out[1] = __NEWARR(NIL, 1, 1, 1, 1, ((ADDRESS)(65536)));
+		OPM_out[2] = __NEWARR(NIL, 1, 1, 1, 1, ((ADDRESS)(16384)));
 	}
+	OPM_outLen[0] = 0;
+	OPM_outLen[1] = 0;
+	OPM_outLen[2] = 0;
 	OPM_MakeFileName((void*)moduleName, moduleName__len, (void*)FName, 32, (CHAR*)".c", 3);
 	OPM_BFile = Files_New(FName, 32);
-	if (OPM_BFile != NIL) {
-		Files_Set(&OPM_R[1], Files_Rider__typ, OPM_BFile, 0);
-	} else {
+	if (OPM_BFile == NIL) {
 		OPM_err(153);
 	}
 	OPM_MakeFileName((void*)moduleName, moduleName__len, (void*)FName, 32, (CHAR*)".h", 3);
 	OPM_HIFile = Files_New(FName, 32);
-	if (OPM_HIFile != NIL) {
-		Files_Set(&OPM_R[2], Files_Rider__typ, OPM_HIFile, 0);
-	} else {
+	if (OPM_HIFile == NIL) {
 		OPM_err(153);
 	}
 }
 
+static void OPM_Emit (Files_File F, INT16 i, CHAR *ext, ADDRESS ext__len)
+{
+	OPM_FileName FName;
+	Files_File old = NIL;
+	Files_Rider R;
+	CHAR b[4096];
+	INT32 pos, n, j;
+	BOOLEAN same;
+	OPM_MakeFileName((void*)OPM_modName, 32, (void*)FName, 32, ext, ext__len);
+	old = Files_Old(FName, 32);
+	same = (old != NIL && Files_Length(old) == OPM_outLen[__X(i, 3)]);
+	if (same) {
+		Files_Set(&R, Files_Rider__typ, old, 0);
+		pos = 0;
+		while ((same && pos < OPM_outLen[__X(i, 3)])) {
+			n = OPM_outLen[__X(i, 3)] - pos;
+			if (n > 4096) {
+				n = 4096;
+			}
+			Files_ReadBytes(&R, Files_Rider__typ, (void*)b, 4096, n);
+			j = 0;
+			while ((j < n && b[__X(j, 4096)] == OPM_out[__X(i, 3)]->data[__X(pos + j, OPM_out[__X(i, 3)]->len[0])])) {
+				j += 1;
+			}
+			same = j == n;
+			pos += n;
+		}
+	}
+	OPM_LogWStr((CHAR*)"  ", 3);
+	OPM_LogWStr(FName, 32);
+	if (same) {
+		OPM_LogWStr((CHAR*)" unchanged.", 12);
+	} else {
+		OPM_LogWStr((CHAR*)" updated.", 10);
+		Files_Set(&R, Files_Rider__typ, F, 0);
+		OPM_WriteBuffer(&R, Files_Rider__typ, i);
+		Files_Register(F);
+	}
+}
+
 void OPM_CloseFiles (void)
 {
 	OPM_FileName FName;
 	INT16 res;
+	OPM_nofBytes = (OPM_outLen[0] + OPM_outLen[1]) + OPM_outLen[2];
 	if (OPM_noerr) {
 		OPM_LogWStr((CHAR*)"  ", 3);
-		OPM_LogWNum(Files_Pos(&OPM_R[1], Files_Rider__typ), 0);
+		OPM_LogWNum(OPM_outLen[1], 0);
 		OPM_LogWStr((CHAR*)" chars.", 8);
 	}
 	if (OPM_noerr) {
 		if (__STRCMP(OPM_modName, "SYSTEM") == 0) {
 			if (!__IN(10, OPM_Options, 32)) {
-				Files_Register(OPM_BFile);
+				OPM_Emit(OPM_BFile, 1, (CHAR*)".c", 3);
 			}
 		} else if (!__IN(10, OPM_Options, 32)) {
-			OPM_Append(&OPM_R[2], Files_Rider__typ, OPM_HFile);
-			Files_Register(OPM_HIFile);
-			Files_Register(OPM_BFile);
+			OPM_currFile = 2;
+			if (OPM_outLen[2] + OPM_outLen[0] > OPM_out[2]->len[0]) {
+				OPM_Grow(OPM_outLen[0]);
+			}
+			__MOVE((ADDRESS)OPM_out[0]->data, (ADDRESS)&OPM_out[2]->data[__X(OPM_outLen[2], OPM_out[2]->len[0])], OPM_outLen[0]);
+			OPM_outLen[2] += OPM_outLen[0];
+			OPM_Emit(OPM_HIFile, 2, (CHAR*)".h", 3);
+			OPM_Emit(OPM_BFile, 1, (CHAR*)".c", 3);
 		} else {
 			OPM_MakeFileName((void*)OPM_modName, 32, (void*)FName, 32, (CHAR*)".h", 3);
 			Files_Delete(FName, 32, &res);
 			OPM_MakeFileName((void*)OPM_modName, 32, (void*)FName, 32, (CHAR*)".sym", 5);
 			Files_Delete(FName, 32, &res);
-			Files_Register(OPM_BFile);
+			OPM_Emit(OPM_BFile, 1, (CHAR*)".c", 3);
 		}
 	}
-	OPM_HFile = NIL;
+	OPM_outLen[0] = 0;
+	OPM_outLen[1] = 0;
+	OPM_outLen[2] = 0;
 	OPM_BFile = NIL;
 	OPM_HIFile = NIL;
 	OPM_newSFile = NIL;
-	OPM_oldSFile = NIL;
-	Files_Set(&OPM_R[0], Files_Rider__typ, NIL, 0);
-	Files_Set(&OPM_R[1], Files_Rider__typ, NIL, 0);
-	Files_Set(&OPM_R[2], Files_Rider__typ, NIL, 0);
+	OPM_oldSF = NIL;
 	Files_Set(&OPM_newSF, Files_Rider__typ, NIL, 0);
-	Files_Set(&OPM_oldSF, Files_Rider__typ, NIL, 0);
 }
 
 static BOOLEAN OPM_IsProbablyInstallDir (CHAR *s, ADDRESS s__len)
@@ -1057,7 +1441,7 @@ static BOOLEAN OPM_IsProbablyInstallDir (CHAR *s, ADDRESS s__len)
 	__DUP(s, s__len, CHAR);
 	__COPY(OPM_InstallDir, testpath, 4096);
 	Strings_Append((CHAR*)"/lib/lib", 9, (void*)testpath, 4096);
-	Strings_Append((CHAR*)"scream", 4, (void*)testpath, 4096);
+	Strings_Append((CHAR*)"scream", 7, (void*)testpath, 4096);
 	Strings_Append((CHAR*)"-O2.a", 6, (void*)testpath, 4096);
 	if (Platform_IdentifyByName(testpath, 4096, &identity, Platform_FileIdentity__typ) != 0) {
 		__DEL(s);
@@ -1084,7 +1468,7 @@ static void OPM_FindInstallDir (void)
 	INT16 i;
 	__COPY(Modules_BinaryDir, OPM_InstallDir, 1024);
 	Strings_Append((CHAR*)"/", 2, (void*)OPM_InstallDir, 1024);
-	Strings_Append((CHAR*)"scream", 4, (void*)OPM_InstallDir, 1024);
+	Strings_Append((CHAR*)"scream", 7, (void*)OPM_InstallDir, 1024);
 	Strings_Append((CHAR*)".d", 3, (void*)OPM_InstallDir, 1024);
 	if (OPM_IsProbablyInstallDir(OPM_InstallDir, 1024)) {
 		return;
@@ -1106,19 +1490,21 @@ static void OPM_FindInstallDir (void)
 static void EnumPtrs(void (*P)(void*))
 {
 	__ENUMR(&OPM_inR, Texts_Reader__typ, 72, 1, P);
+	P(OPM_src);
 	P(OPM_Log);
 	P(OPM_Errors);
-	__ENUMR(&OPM_oldSF, Files_Rider__typ, 24, 1, P);
+	P(OPM_symFiles);
+	P(OPM_oldSF);
 	__ENUMR(&OPM_newSF, Files_Rider__typ, 24, 1, P);
-	__ENUMR(OPM_R, Files_Rider__typ, 24, 3, P);
-	P(OPM_oldSFile);
+	__ENUMP(OPM_out, 3, P);
 	P(OPM_newSFile);
-	P(OPM_HFile);
 	P(OPM_BFile);
 	P(OPM_HIFile);
 }
 
 
+__TDESC(OPM_SymFileDesc, 1, 1) = {__TDFLDS("SymFileDesc", 72), {64, -16}};
+
 export void *OPM__init(void)
 {
 	__DEFMOD;
@@ -1127,6 +1513,7 @@ export void *OPM__init(void)
 	__MODULE_IMPORT(Modules);
 	__MODULE_IMPORT(Out);
 	__MODULE_IMPORT(Platform);
+	__MODULE_IMPORT(Reals);
 	__MODULE_IMPORT(Strings);
 	__MODULE_IMPORT(Texts);
 	__MODULE_IMPORT(VT100);
@@ -1137,6 +1524,7 @@ export void *OPM__init(void)
 	__REGCMD("LogWLn", OPM_LogWLn);
 	__REGCMD("RegisterNewSym", OPM_RegisterNewSym);
 	__REGCMD("WriteLn", OPM_WriteLn);
+	__INITYP(OPM_SymFileDesc, OPM_SymFileDesc, 0);
 /* BEGIN */
 	OPM_MaxReal =   3.40282346000000e+038;
 	OPM_MaxLReal =   1.79769296342094e+308;
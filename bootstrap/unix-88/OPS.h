@@ -5,6 +5,12 @@
 
 #include "SYSTEM.h"
 
+typedef
+	struct {
+		ADDRESS len[1];
+		CHAR data[1];
+	} *OPS_Ident;
+
 typedef
 	CHAR OPS_Name[256];
 
@@ -13,15 +19,20 @@ typedef
 
 
 import OPS_Name OPS_name;
+import INT32 OPS_hash;
+import OPS_Ident OPS_ident;
 import OPS_String OPS_str;
 import INT16 OPS_numtyp;
 import INT64 OPS_intval;
 import REAL OPS_realval;
 import LONGREAL OPS_lrlval;
+import INT32 OPS_nofTokens;
 
 
 import void OPS_Get (INT8 *sym);
+import INT32 OPS_HashOf (CHAR *name, ADDRESS name__len);
 import void OPS_Init (void);
+import OPS_Ident OPS_Intern (CHAR *name, ADDRESS name__len);
 import void *OPS__init(void);
 
 
@@ -8,14 +8,20 @@
 #include "SYSTEM.h"
 #include "Heap.h"
 #include "Platform.h"
+#include "Reals.h"
 
 
 export BOOLEAN Out_IsConsole;
-static CHAR Out_buf[128];
-static INT16 Out_in;
+static struct {
+	ADDRESS len[1];
+	CHAR data[1];
+} *Out_buf;
+static INT32 Out_in;
+static BOOLEAN Out_lineBuffered;
 
 
 export void Out_Char (CHAR ch);
+static void Out_Finalize (SYSTEM_PTR o);
 export void Out_Flush (void);
 export void Out_Hex (INT64 x, INT64 n);
 export void Out_Int (INT64 x, INT64 n);
@@ -25,34 +31,50 @@ export void Out_LongReal (LONGREAL x, INT16 n);
 export void Out_Open (void);
 export void Out_Real (REAL x, INT16 n);
 static void Out_RealP (LONGREAL x, INT16 n, BOOLEAN long_);
+export void Out_SetBuffer (INT32 size, BOOLEAN lineBuffered);
 export void Out_String (CHAR *str, ADDRESS str__len);
 export LONGREAL Out_Ten (INT16 e);
 static void Out_digit (INT64 n, CHAR *s, ADDRESS s__len, INT16 *i);
 static void Out_prepend (CHAR *t, ADDRESS t__len, CHAR *s, ADDRESS s__len, INT16 *i);
 
-#define Out_Entier64(x)	(INT64)(x)
 
 void Out_Flush (void)
 {
 	INT16 error;
 	if (Out_in > 0) {
-		error = Platform_Write(1, (ADDRESS)Out_buf, Out_in);
+		error = Platform_Write(1, (ADDRESS)&Out_buf->data[0], Out_in);
 	}
 	Out_in = 0;
 }
 
+static void Out_Finalize (SYSTEM_PTR o)
+{
+	Out_Flush();
+}
+
+void Out_SetBuffer (INT32 size, BOOLEAN lineBuffered)
+{
+	Out_Flush();
+	if (size < 1) {
+		size = 1;
+	}
+	Out_buf = __NEWARR(NIL, 1, 1, 1, 1, ((ADDRESS)(size)));
+	Heap_RegisterFinalizer((void*)Out_buf, Out_Finalize);
+	Out_lineBuffered = lineBuffered;
+}
+
 void Out_Open (void)
 {
 }
 
 void Out_Char (CHAR ch)
 {
-	if (Out_in >= 128) {
+	if (Out_in >= Out_buf->len[0]) {
 		Out_Flush();
 	}
-	Out_buf[__X(Out_in, 128)] = ch;
+	Out_buf->data[__X(Out_in, Out_buf->len[0])] = ch;
 	Out_in += 1;
-	if (ch == 0x0a) {
+	if ((ch == 0x0a && Out_lineBuffered)) {
 		Out_Flush();
 	}
 }
@@ -73,14 +95,14 @@ void Out_String (CHAR *str, ADDRESS str__len)
 	INT16 error;
 	__DUP(str, str__len, CHAR);
 	l = Out_Length((void*)str, str__len);
-	if (Out_in + l > 128) {
+	if (Out_in + l > Out_buf->len[0]) {
 		Out_Flush();
 	}
-	if (l > 128) {
+	if (l > Out_buf->len[0]) {
 		error = Platform_Write(1, (ADDRESS)str, l);
 	} else {
-		__MOVE((ADDRESS)str, (ADDRESS)&Out_buf[__X(Out_in, 128)], l);
-		Out_in += __SHORT(l, 32768);
+		__MOVE((ADDRESS)str, (ADDRESS)&Out_buf->data[__X(Out_in, Out_buf->len[0])], l);
+		Out_in += l;
 	}
 	__DEL(str);
 }
@@ -148,7 +170,9 @@ void Out_Hex (INT64 x, INT64 n)
 void Out_Ln (void)
 {
 	Out_String(Platform_NL, 3);
-	Out_Flush();
+	if (Out_lineBuffered) {
+		Out_Flush();
+	}
 }
 
 static void Out_digit (INT64 n, CHAR *s, ADDRESS s__len, INT16 *i)
@@ -196,9 +220,8 @@ static void Out_RealP (LONGREAL x, INT16 n, BOOLEAN long_)
 	INT64 f;
 	CHAR s[30];
 	INT16 i, el;
-	LONGREAL x0;
 	BOOLEAN nn, en;
-	INT64 m;
+	CHAR m[17];
 	INT16 d, dr;
 	e = (INT16)__MASK(__ASHR((__VAL(INT64, x)), 52), -2048);
 	f = __MASK((__VAL(INT64, x)), -4503599627370496LL);
@@ -220,67 +243,29 @@ static void Out_RealP (LONGREAL x, INT16 n, BOOLEAN long_)
 			if (dr > 17) {
 				dr = 17;
 			}
-			d = dr;
-			if (d < 15) {
-				d = 15;
-			}
+			d = Reals_DigitsL(x, 0, (void*)m, 17, &e);
 		} else {
 			el = 2;
 			dr = n - 5;
 			if (dr > 9) {
 				dr = 9;
 			}
-			d = dr;
-			if (d < 6) {
-				d = 6;
-			}
+			d = Reals_Digits((REAL)x, 0, (void*)m, 17, &e);
 		}
-		if (e == 0) {
-			while (el > 0) {
-				i -= 1;
-				s[__X(i, 30)] = '0';
-				el -= 1;
-			}
-			i -= 1;
-			s[__X(i, 30)] = '+';
-			m = 0;
+		en = e < 0;
+		if (en) {
+			e = -e;
+		}
+		while (el > 0) {
+			Out_digit(e, (void*)s, 30, &i);
+			e = __DIV(e, 10);
+			el -= 1;
+		}
+		i -= 1;
+		if (en) {
+			s[__X(i, 30)] = '-';
 		} else {
-			if (nn) {
-				x = -x;
-			}
-			e = __SHORT(__ASHR((e - 1023) * 77, 8), 32768);
-			if (e >= 0) {
-				x = x / (LONGREAL)Out_Ten(e);
-			} else {
-				x = Out_Ten(-e) * x;
-			}
-			if (x >= (LONGREAL)10) {
-				x =   1.00000000000000e-001 * x;
-				e += 1;
-			}
-			en = e < 0;
-			if (en) {
-				e = -e;
-			}
-			while (el > 0) {
-				Out_digit(e, (void*)s, 30, &i);
-				e = __DIV(e, 10);
-				el -= 1;
-			}
-			i -= 1;
-			if (en) {
-				s[__X(i, 30)] = '-';
-			} else {
-				s[__X(i, 30)] = '+';
-			}
-			x0 = Out_Ten(d - 1);
-			x = x0 * x;
-			x = x +   5.00000000000000e-001;
-			if (x >= (LONGREAL)10 * x0) {
-				x =   1.00000000000000e-001 * x;
-				e += 1;
-			}
-			m = Out_Entier64(x);
+			s[__X(i, 30)] = '+';
 		}
 		i -= 1;
 		if (long_) {
@@ -291,18 +276,20 @@ static void Out_RealP (LONGREAL x, INT16 n, BOOLEAN long_)
 		if (dr < 2) {
 			dr = 2;
 		}
-		while ((d > dr && __MOD(m, 10) == 0)) {
-			m = __DIV(m, 10);
-			d -= 1;
+		while (dr > d) {
+			i -= 1;
+			s[__X(i, 30)] = '0';
+			dr -= 1;
 		}
 		while (d > 1) {
-			Out_digit(m, (void*)s, 30, &i);
-			m = __DIV(m, 10);
 			d -= 1;
+			i -= 1;
+			s[__X(i, 30)] = m[__X(d, 17)];
 		}
 		i -= 1;
 		s[__X(i, 30)] = '.';
-		Out_digit(m, (void*)s, 30, &i);
+		i -= 1;
+		s[__X(i, 30)] = m[0];
 	}
 	n -= 30 - i;
 	while (n > 0) {
@@ -328,18 +315,25 @@ void Out_LongReal (LONGREAL x, INT16 n)
 	Out_RealP(x, n, 1);
 }
 
+static void EnumPtrs(void (*P)(void*))
+{
+	P(Out_buf);
+}
+
 
 export void *Out__init(void)
 {
 	__DEFMOD;
 	__MODULE_IMPORT(Heap);
 	__MODULE_IMPORT(Platform);
-	__REGMOD("Out", 0);
+	__MODULE_IMPORT(Reals);
+	__REGMOD("Out", EnumPtrs);
 	__REGCMD("Flush", Out_Flush);
 	__REGCMD("Ln", Out_Ln);
 	__REGCMD("Open", Out_Open);
 /* BEGIN */
 	Out_IsConsole = Platform_IsConsole(1);
 	Out_in = 0;
+	Out_SetBuffer(65536, Out_IsConsole);
 	__ENDMOD;
 }
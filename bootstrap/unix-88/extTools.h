@@ -4,12 +4,16 @@
 #define extTools__h
 
 #include "SYSTEM.h"
+#include "Files.h"
 
 
+import BOOLEAN extTools_useProfile;
 
 
-import void extTools_Assemble (CHAR *moduleName, ADDRESS moduleName__len);
+import void extTools_Assemble (CHAR *moduleName, ADDRESS moduleName__len, Files_File state);
 import void extTools_LinkMain (CHAR *moduleName, ADDRESS moduleName__len, BOOLEAN statically, CHAR *additionalopts, ADDRESS additionalopts__len);
+import void extTools_Train (CHAR *moduleName, ADDRESS moduleName__len);
+import void extTools_WaitAll (void);
 import void *extTools__init(void);
 
 
@@ -31,6 +31,7 @@ import OPT_Node OPB_NewString (OPS_String str, INT64 len);
 import OPT_Node OPB_Nil (void);
 import void OPB_Op (INT8 op, OPT_Node *x, OPT_Node y);
 import void OPB_OptIf (OPT_Node *x);
+import void OPB_Optimize (OPT_Node n);
 import void OPB_Param (OPT_Node ap, OPT_Object fp);
 import void OPB_PrepCall (OPT_Node *x, OPT_Object *fpar);
 import void OPB_Return (OPT_Node *x, OPT_Object proc);
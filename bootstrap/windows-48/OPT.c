@@ -6,8 +6,10 @@
 #define SET      UINT32
 
 #include "SYSTEM.h"
+#include "Heap.h"
 #include "OPM.h"
 #include "OPS.h"
+#include "Platform.h"
 
 typedef
 	struct OPT_ConstDesc *OPT_Const;
@@ -24,31 +26,43 @@ typedef
 		LONGREAL realval;
 	} OPT_ConstDesc;
 
-typedef
-	struct OPT_ExpCtxt {
-		INT32 reffp;
-		INT16 ref;
-		INT8 nofm;
-		INT8 locmno[64];
-	} OPT_ExpCtxt;
-
 typedef
 	struct OPT_StrDesc *OPT_Struct;
 
 typedef
 	struct OPT_ObjDesc *OPT_Object;
 
+typedef
+	struct OPT_SymModDesc *OPT_SymMod;
+
 typedef
 	struct OPT_ImpCtxt {
 		INT32 nextTag, reffp;
-		INT16 nofr, minr, nofm;
+		INT16 nofp, depth;
 		BOOLEAN self;
-		OPT_Struct ref[255];
-		OPT_Object old[255];
-		INT32 pvfp[255];
-		INT8 glbmno[64];
+		OPT_SymMod sm;
+		OPT_Struct ref[14];
+		INT32 pending[255];
 	} OPT_ImpCtxt;
 
+typedef
+	struct OPT_ExpCtxt {
+		INT32 reffp;
+		INT16 ref;
+		INT8 nofm;
+		INT8 locmno[64], mods[64];
+		INT32 nofo;
+		INT32 strpos[255];
+		struct {
+			ADDRESS len[1];
+			OPT_Struct data[1];
+		} *strs;
+		struct {
+			ADDRESS len[1];
+			INT32 data[1];
+		} *objs;
+	} OPT_ExpCtxt;
+
 typedef
 	struct OPT_LinkDesc *OPT_Link;
 
@@ -65,7 +79,7 @@ typedef
 	struct OPT_NodeDesc {
 		OPT_Node left, right, link;
 		INT8 class, subcl;
-		BOOLEAN readonly;
+		BOOLEAN readonly, nocheck;
 		OPT_Struct typ;
 		OPT_Object obj;
 		OPT_Const conval;
@@ -74,15 +88,17 @@ typedef
 typedef
 	struct OPT_ObjDesc {
 		OPT_Object left, right, link, scope;
-		OPS_Name name;
+		OPS_Ident name;
 		BOOLEAN leaf;
 		INT8 mode, mnolev, vis, history;
-		BOOLEAN used, fpdone;
+		BOOLEAN used, fpdone, nocopy;
 		INT32 fprint;
 		OPT_Struct typ;
 		OPT_Const conval;
 		INT32 adr, linkadr;
 		INT16 x;
+		INT32 hash;
+		OPT_Object hroot, hnext;
 	} OPT_ObjDesc;
 
 typedef
@@ -96,6 +112,25 @@ typedef
 		OPT_Object link, strobj;
 	} OPT_StrDesc;
 
+typedef
+	struct OPT_SymModDesc {
+		OPM_SymFile sf;
+		INT32 nofStrs, strTab, nofObjs, objTab, hashSize, hashTab;
+		INT8 glbmno[64];
+		struct {
+			ADDRESS len[1];
+			OPT_Struct data[1];
+		} *ref, *str;
+		struct {
+			ADDRESS len[1];
+			OPT_Object data[1];
+		} *old;
+		struct {
+			ADDRESS len[1];
+			INT32 data[1];
+		} *pvfp;
+	} OPT_SymModDesc;
+
 
 export OPT_Object OPT_topScope;
 export OPT_Struct OPT_undftyp, OPT_niltyp, OPT_notyp, OPT_bytetyp, OPT_cpbytetyp, OPT_booltyp, OPT_chartyp, OPT_sinttyp, OPT_inttyp, OPT_linttyp, OPT_hinttyp, OPT_int8typ, OPT_int16typ, OPT_int32typ, OPT_int64typ, OPT_settyp, OPT_set32typ, OPT_set64typ, OPT_realtyp, OPT_lrltyp, OPT_stringtyp, OPT_adrtyp, OPT_sysptrtyp;
@@ -107,10 +142,27 @@ export BOOLEAN OPT_SYSimported;
 static OPT_Object OPT_universe, OPT_syslink;
 static OPT_ImpCtxt OPT_impCtxt;
 static OPT_ExpCtxt OPT_expCtxt;
+static OPT_SymMod OPT_symMods[64];
 static INT32 OPT_nofhdfld;
 static BOOLEAN OPT_newsf, OPT_findpc, OPT_extsf, OPT_sfpresent, OPT_symExtended, OPT_symNew;
 static INT32 OPT_recno;
 export OPT_Link OPT_Links;
+export INT32 OPT_nofNodes, OPT_nofImported;
+static struct {
+	ADDRESS len[1];
+	OPT_Object data[1];
+} *OPT_index;
+static INT32 OPT_nofEntries;
+static BOOLEAN OPT_region;
+static OPT_Object OPT_cacheMod[64];
+static Platform_FileIdentity OPT_cacheId[64];
+static INT32 OPT_cacheLen[64];
+static UINT64 OPT_cacheDeps[64];
+static INT8 OPT_nofCache;
+static CHAR OPT_cacheModel;
+static INT16 OPT_cacheAdrSize, OPT_cacheAlign;
+static BOOLEAN OPT_useCache, OPT_splicing, OPT_warming;
+static UINT64 OPT_spliced;
 
 export ADDRESS *OPT_ConstDesc__typ;
 export ADDRESS *OPT_ObjDesc__typ;
@@ -118,10 +170,13 @@ export ADDRESS *OPT_StrDesc__typ;
 export ADDRESS *OPT_NodeDesc__typ;
 export ADDRESS *OPT_ImpCtxt__typ;
 export ADDRESS *OPT_ExpCtxt__typ;
+export ADDRESS *OPT_SymModDesc__typ;
 export ADDRESS *OPT_LinkDesc__typ;
 
 export void OPT_Align (INT32 *adr, INT32 base);
+static void OPT_Attach (INT8 s);
 export INT32 OPT_BaseAlignment (OPT_Struct typ);
+static BOOLEAN OPT_CacheCurrent (INT8 s);
 export void OPT_Close (void);
 export void OPT_CloseScope (void);
 static void OPT_DebugStruct (OPT_Struct btyp);
@@ -138,25 +193,35 @@ export void OPT_FPrintStr (OPT_Struct typ);
 export void OPT_Find (OPT_Object *res);
 export void OPT_FindField (OPS_Name name, OPT_Struct typ, OPT_Object *res);
 export void OPT_FindImport (OPT_Object mod, OPT_Object *res);
+static void OPT_GrowIndex (void);
 export void OPT_IdFPrint (OPT_Struct typ);
 export void OPT_Import (OPS_Name aliasName, OPS_Name name, BOOLEAN *done);
 static void OPT_InConstant (INT32 f, OPT_Const conval);
 static OPT_Object OPT_InFld (void);
+static OPT_SymMod OPT_InHeader (OPM_SymFile sf);
 static void OPT_InLinks (void);
-static void OPT_InMod (INT8 *mno);
+static void OPT_InMod (OPM_SymFile sf, INT8 *mno);
 static void OPT_InName (CHAR *name, ADDRESS name__len);
-static OPT_Object OPT_InObj (INT8 mno);
+static OPT_Object OPT_InObj (OPT_SymMod sm, INT32 k);
+static OPT_Struct OPT_InRef (INT32 ref);
 static void OPT_InSign (INT8 mno, OPT_Struct *res, OPT_Object *par);
 static void OPT_InStruct (OPT_Struct *typ);
 static OPT_Object OPT_InTProc (INT8 mno);
 static OPT_Struct OPT_InTyp (INT32 tag);
+static void OPT_IndexObj (OPT_Object root, OPT_Object obj, INT32 hash);
+static void OPT_IndexTree (OPT_Object root, OPT_Object obj);
+static void OPT_IndexTypes (OPT_Object obj);
 export void OPT_Init (OPS_Name name, UINT32 opt);
 export void OPT_InitRecno (void);
 static void OPT_InitStruct (OPT_Struct *typ, INT8 form);
 export void OPT_Insert (OPS_Name name, OPT_Object *obj);
 export void OPT_InsertImport (OPT_Object obj, OPT_Object *root, OPT_Object *old);
+static void OPT_InsertScope (OPT_Object obj, OPT_Object *root, OPT_Object *old);
+static void OPT_InsertTreap (OPT_Object obj, INT32 prio, OPT_Object *root, OPT_Object *old);
 export INT16 OPT_IntSize (INT64 n);
 export OPT_Struct OPT_IntType (INT32 size);
+static INT8 OPT_Load (CHAR *name, ADDRESS name__len);
+static OPT_Object OPT_Lookup (OPT_Object root, OPS_Ident name, INT32 hash);
 export OPT_Const OPT_NewConst (void);
 export OPT_ConstExt OPT_NewExt (void);
 export OPT_Node OPT_NewNode (INT8 class);
@@ -164,6 +229,7 @@ export OPT_Object OPT_NewObj (void);
 export OPT_Struct OPT_NewStr (INT8 form, INT8 comp);
 export void OPT_OpenScope (INT8 level, OPT_Object owner);
 static void OPT_OutConstant (OPT_Object obj);
+static void OPT_OutEntry (OPT_Object obj);
 static void OPT_OutFlds (OPT_Object fld, INT32 adr, BOOLEAN visible);
 static void OPT_OutHdFld (OPT_Struct typ, OPT_Object fld, INT32 adr);
 static void OPT_OutLinks (void);
@@ -172,11 +238,21 @@ static void OPT_OutName (CHAR *name, ADDRESS name__len);
 static void OPT_OutObj (OPT_Object obj);
 static void OPT_OutSign (OPT_Struct result, OPT_Object par);
 static void OPT_OutStr (OPT_Struct typ);
+static void OPT_OutStrDef (OPT_Struct typ);
 static void OPT_OutTProcs (OPT_Struct typ, OPT_Object obj);
+static void OPT_Rebase (OPT_Object obj, INT8 s, INT8 m);
+static void OPT_RebaseFlds (OPT_Object fld, INT8 s, INT8 m);
+static void OPT_RebaseList (OPT_Object par, INT8 s, INT8 m);
+static void OPT_ResetIndex (void);
 export OPT_Struct OPT_SetType (INT32 size);
 export OPT_Struct OPT_ShorterOrLongerType (OPT_Struct x, INT16 dir);
 export INT32 OPT_SizeAlignment (INT32 size);
+static INT32 OPT_Slot (OPT_Object root, INT32 hash);
+static void OPT_Splice (CHAR *name, ADDRESS name__len);
+static INT32 OPT_SymIndex (OPT_SymMod sm, OPS_Ident name, INT32 hash);
 export void OPT_TypSize (OPT_Struct typ);
+export void OPT_UseCache (void);
+export void OPT_Warm (CHAR *names, ADDRESS names__len);
 static void OPT_err (INT16 n);
 
 
@@ -380,21 +456,34 @@ void OPT_TypSize (OPT_Struct typ)
 OPT_Const OPT_NewConst (void)
 {
 	OPT_Const const_ = NIL;
-	__NEW(const_, OPT_ConstDesc);
+	if (OPT_region) {
+		const_ = (OPT_Const)(ADDRESS)Heap_RegionRec((ADDRESS)OPT_ConstDesc__typ);
+	} else {
+		__NEW(const_, OPT_ConstDesc);
+	}
 	return const_;
 }
 
 OPT_Object OPT_NewObj (void)
 {
 	OPT_Object obj = NIL;
-	__NEW(obj, OPT_ObjDesc);
+	if (OPT_region) {
+		obj = (OPT_Object)(ADDRESS)Heap_RegionRec((ADDRESS)OPT_ObjDesc__typ);
+	} else {
+		__NEW(obj, OPT_ObjDesc);
+	}
+	obj->name = OPS_Intern((CHAR*)"", 1);
 	return obj;
 }
 
 OPT_Struct OPT_NewStr (INT8 form, INT8 comp)
 {
 	OPT_Struct typ = NIL;
-	__NEW(typ, OPT_StrDesc);
+	if (OPT_region) {
+		typ = (OPT_Struct)(ADDRESS)Heap_RegionRec((ADDRESS)OPT_StrDesc__typ);
+	} else {
+		__NEW(typ, OPT_StrDesc);
+	}
 	typ->form = form;
 	typ->comp = comp;
 	typ->ref = 255;
@@ -409,7 +498,12 @@ OPT_Struct OPT_NewStr (INT8 form, INT8 comp)
 OPT_Node OPT_NewNode (INT8 class)
 {
 	OPT_Node node = NIL;
-	__NEW(node, OPT_NodeDesc);
+	if (OPT_region) {
+		node = (OPT_Node)(ADDRESS)Heap_RegionRec((ADDRESS)OPT_NodeDesc__typ);
+	} else {
+		__NEW(node, OPT_NodeDesc);
+	}
+	OPT_nofNodes += 1;
 	node->class = class;
 	return node;
 }
@@ -417,7 +511,11 @@ OPT_Node OPT_NewNode (INT8 class)
 OPT_ConstExt OPT_NewExt (void)
 {
 	OPT_ConstExt ext = NIL;
-	ext = __NEWARR(NIL, 1, 1, 1, 0, 256);
+	if (OPT_region) {
+		ext = (OPT_ConstExt)(ADDRESS)Heap_RegionBlk(256);
+	} else {
+		ext = __NEWARR(NIL, 1, 1, 1, 0, 256);
+	}
 	return ext;
 }
 
@@ -442,15 +540,105 @@ void OPT_CloseScope (void)
 	OPT_topScope = OPT_topScope->left;
 }
 
+static INT32 OPT_Slot (OPT_Object root, INT32 hash)
+{
+	INT32 h;
+	h = (INT32)(((UINT32)hash ^ (UINT32)((ADDRESS)root >> 4)) * 16777619);
+	return __MASK(h, -(INT32)OPT_index->len[0]);
+}
+
+static void OPT_ResetIndex (void)
+{
+	OPT_index = __NEWARR(POINTER__typ, 4, 4, 1, 1, ((ADDRESS)(1024)));
+	OPT_nofEntries = 0;
+}
+
+static void OPT_GrowIndex (void)
+{
+	INT32 i, slot;
+	OPT_Object obj = NIL, next = NIL;
+	struct {ADDRESS len[1]; OPT_Object data[1];} *old = NIL;
+	old = (void*)OPT_index;
+	OPT_index = __NEWARR(POINTER__typ, 4, 4, 1, 1, ((ADDRESS)(2 * old->len[0])));
+	i = 0;
+	while (i < old->len[0]) {
+		obj = old->data[__X(i, old->len[0])];
+		while (obj != NIL) {
+			next = obj->hnext;
+			slot = OPT_Slot(obj->hroot, obj->hash);
+			obj->hnext = OPT_index->data[__X(slot, OPT_index->len[0])];
+			OPT_index->data[__X(slot, OPT_index->len[0])] = obj;
+			obj = next;
+		}
+		i += 1;
+	}
+}
+
+static void OPT_IndexObj (OPT_Object root, OPT_Object obj, INT32 hash)
+{
+	INT32 slot;
+	if (OPT_nofEntries >= 2 * OPT_index->len[0]) {
+		OPT_GrowIndex();
+	}
+	obj->hash = hash;
+	obj->hroot = root;
+	slot = OPT_Slot(root, hash);
+	obj->hnext = OPT_index->data[__X(slot, OPT_index->len[0])];
+	OPT_index->data[__X(slot, OPT_index->len[0])] = obj;
+	OPT_nofEntries += 1;
+}
+
+static void OPT_IndexTree (OPT_Object root, OPT_Object obj)
+{
+	if (obj != NIL) {
+		OPT_IndexTree(root, obj->left);
+		OPT_IndexObj(root, obj, OPS_HashOf((void*)obj->name->data, obj->name->len[0]));
+		OPT_IndexTree(root, obj->right);
+	}
+}
+
+static void OPT_IndexTypes (OPT_Object obj)
+{
+	if (obj != NIL) {
+		OPT_IndexTypes(obj->left);
+		if ((((obj->mode == 5 && obj->typ->strobj == obj)) && obj->typ->comp == 4)) {
+			OPT_IndexTree(obj->typ->link, obj->typ->link);
+		}
+		OPT_IndexTypes(obj->right);
+	}
+}
+
+static OPT_Object OPT_Lookup (OPT_Object root, OPS_Ident name, INT32 hash)
+{
+	OPT_Object obj = NIL;
+	if (root == NIL) {
+		return NIL;
+	}
+	obj = OPT_index->data[__X(OPT_Slot(root, hash), OPT_index->len[0])];
+	while (obj != NIL) {
+		if ((obj->hroot == root && obj->name == name)) {
+			return obj;
+		}
+		obj = obj->hnext;
+	}
+	return NIL;
+}
+
 void OPT_Init (OPS_Name name, UINT32 opt)
 {
+	OPT_ResetIndex();
+	OPT_IndexTree(OPT_universe->right, OPT_universe->right);
+	OPT_IndexTree(OPT_syslink, OPT_syslink);
 	OPT_topScope = OPT_universe;
+	OPT_region = !OPT_warming;
 	OPT_OpenScope(0, NIL);
 	OPT_SYSimported = 0;
 	__MOVE(name, OPT_SelfName, 256);
-	__MOVE(name, OPT_topScope->name, 256);
+	OPT_topScope->name = OPS_Intern(name, 256);
 	OPT_GlbMod[0] = OPT_topScope;
 	OPT_nofGmod = 1;
+	OPT_splicing = ((((((OPT_useCache && OPT_nofCache > 1)) && OPT_cacheModel == OPM_Model[0])) && OPT_cacheAdrSize == OPM_AddressSize)) && OPT_cacheAlign == OPM_Alignment;
+	OPT_spliced = 0x0;
 	OPT_newsf = __IN(4, opt, 32);
 	OPT_findpc = __IN(8, opt, 32);
 	OPT_extsf = OPT_newsf || __IN(9, opt, 32);
@@ -468,33 +656,80 @@ void OPT_Close (void)
 		OPT_GlbMod[__X(i, 64)] = NIL;
 		i += 1;
 	}
-	i = 14;
-	while (i < 255) {
-		OPT_impCtxt.ref[__X(i, 255)] = NIL;
-		OPT_impCtxt.old[__X(i, 255)] = NIL;
+	i = 0;
+	while (i < 64) {
+		OPT_symMods[__X(i, 64)] = NIL;
 		i += 1;
 	}
+	OPT_impCtxt.sm = NIL;
+	if (OPT_useCache) {
+		i = 0;
+		while (i < 64) {
+			OPT_cacheMod[__X(i, 64)] = NIL;
+			i += 1;
+		}
+		OPT_nofCache = 0;
+		OPT_useCache = 0;
+		OPT_splicing = 0;
+	}
+	if (OPT_region) {
+		Heap_ReleaseRegion();
+		OPT_region = 0;
+	}
+}
+
+static INT32 OPT_SymIndex (OPT_SymMod sm, OPS_Ident name, INT32 hash)
+{
+	INT32 slot, k;
+	OPS_Name s;
+	slot = __MASK(hash, -sm->hashSize);
+	for (;;) {
+		OPM_SymSelect(sm->sf, sm->hashTab + __ASHL(slot, 2));
+		k = OPM_SymRLInt() - 1;
+		if (k < 0) {
+			return -1;
+		}
+		OPM_SymSelect(sm->sf, (sm->objTab + __ASHL(k, 3)) + 4);
+		if (OPM_SymRLInt() == hash) {
+			OPM_SymSelect(sm->sf, sm->objTab + __ASHL(k, 3));
+			OPM_SymSelect(sm->sf, OPM_SymRLInt());
+			OPT_InName((void*)s, 256);
+			if (__STRCMP(s, name->data) == 0) {
+				return k;
+			}
+		}
+		slot = __MASK(slot + 1, -sm->hashSize);
+	}
+	__RETCHK;
 }
 
 void OPT_FindImport (OPT_Object mod, OPT_Object *res)
 {
 	OPT_Object obj = NIL;
-	obj = mod->scope;
-	for (;;) {
-		if (obj == NIL) {
-			break;
+	OPT_SymMod sm = NIL;
+	INT32 k;
+	if (mod->mnolev == 0) {
+		obj = OPT_Lookup(mod->scope, OPS_ident, OPS_hash);
+	} else {
+		obj = OPT_Lookup(OPT_GlbMod[__X(-mod->mnolev, 64)]->right, OPS_ident, OPS_hash);
+		sm = OPT_symMods[__X(-mod->mnolev, 64)];
+		if (((obj == NIL || (obj->mode == 5 && obj->vis == 0)) && sm != NIL)) {
+			k = OPT_SymIndex(sm, OPS_ident, OPS_hash);
+			if (k >= 0) {
+				OPM_StartPhase(1);
+				OPT_impCtxt.self = 0;
+				obj = OPT_InObj(sm, k);
+				OPT_nofImported += 1;
+				OPM_StopPhase(1);
+			}
+			OPM_CloseOldSym();
 		}
-		if (__STRCMP(OPS_name, obj->name) < 0) {
-			obj = obj->left;
-		} else if (__STRCMP(OPS_name, obj->name) > 0) {
-			obj = obj->right;
+	}
+	if (obj != NIL) {
+		if ((obj->mode == 5 && obj->vis == 0)) {
+			obj = NIL;
 		} else {
-			if ((obj->mode == 5 && obj->vis == 0)) {
-				obj = NIL;
-			} else {
-				obj->used = 1;
-			}
-			break;
+			obj->used = 1;
 		}
 	}
 	*res = obj;
@@ -505,19 +740,7 @@ void OPT_Find (OPT_Object *res)
 	OPT_Object obj = NIL, head = NIL;
 	head = OPT_topScope;
 	for (;;) {
-		obj = head->right;
-		for (;;) {
-			if (obj == NIL) {
-				break;
-			}
-			if (__STRCMP(OPS_name, obj->name) < 0) {
-				obj = obj->left;
-			} else if (__STRCMP(OPS_name, obj->name) > 0) {
-				obj = obj->right;
-			} else {
-				break;
-			}
-		}
+		obj = OPT_Lookup(head->right, OPS_ident, OPS_hash);
 		if (obj != NIL) {
 			break;
 		}
@@ -532,17 +755,15 @@ void OPT_Find (OPT_Object *res)
 void OPT_FindField (OPS_Name name, OPT_Struct typ, OPT_Object *res)
 {
 	OPT_Object obj = NIL;
+	OPS_Ident id = NIL;
+	INT32 hash;
+	id = OPS_Intern(name, 256);
+	hash = OPS_HashOf(name, 256);
 	while (typ != NIL) {
-		obj = typ->link;
-		while (obj != NIL) {
-			if (__STRCMP(name, obj->name) < 0) {
-				obj = obj->left;
-			} else if (__STRCMP(name, obj->name) > 0) {
-				obj = obj->right;
-			} else {
-				*res = obj;
-				return;
-			}
+		obj = OPT_Lookup(typ->link, id, hash);
+		if (obj != NIL) {
+			*res = obj;
+			return;
 		}
 		typ = typ->BaseTyp;
 	}
@@ -551,42 +772,14 @@ void OPT_FindField (OPS_Name name, OPT_Struct typ, OPT_Object *res)
 
 void OPT_Insert (OPS_Name name, OPT_Object *obj)
 {
-	OPT_Object ob0 = NIL, ob1 = NIL;
-	BOOLEAN left;
-	INT8 mnolev;
-	ob0 = OPT_topScope;
-	ob1 = ob0->right;
-	left = 0;
-	for (;;) {
-		if (ob1 != NIL) {
-			if (__STRCMP(name, ob1->name) < 0) {
-				ob0 = ob1;
-				ob1 = ob0->left;
-				left = 1;
-			} else if (__STRCMP(name, ob1->name) > 0) {
-				ob0 = ob1;
-				ob1 = ob0->right;
-				left = 0;
-			} else {
-				OPT_err(1);
-				ob0 = ob1;
-				ob1 = ob0->right;
-			}
-		} else {
-			ob1 = OPT_NewObj();
-			ob1->leaf = 1;
-			if (left) {
-				ob0->left = ob1;
-			} else {
-				ob0->right = ob1;
-			}
-			ob1->left = NIL;
-			ob1->right = NIL;
-			__COPY(name, ob1->name, 256);
-			mnolev = OPT_topScope->mnolev;
-			ob1->mnolev = mnolev;
-			break;
-		}
+	OPT_Object ob1 = NIL, old = NIL;
+	ob1 = OPT_NewObj();
+	ob1->leaf = 1;
+	ob1->name = OPS_Intern(name, 256);
+	ob1->mnolev = OPT_topScope->mnolev;
+	OPT_InsertScope(ob1, &OPT_topScope->right, &old);
+	if (old != NIL) {
+		OPT_err(1);
 	}
 	*obj = ob1;
 }
@@ -611,7 +804,7 @@ static void OPT_DebugStruct (OPT_Struct btyp)
 		OPM_LogWLn();
 	}
 	OPM_LogWStr((CHAR*)"btyp^.strobji^.name = ", 23);
-	OPM_LogWStr(btyp->strobj->name, 256);
+	OPM_LogWStr(btyp->strobj->name->data, btyp->strobj->name->len[0]);
 	OPM_LogWLn();
 	OPM_LogWStr((CHAR*)"btyp^.form = ", 14);
 	OPM_LogWNum(btyp->form, 0);
@@ -666,9 +859,9 @@ void OPT_IdFPrint (OPT_Struct typ)
 		OPM_FPrint(&idfp, c);
 		btyp = typ->BaseTyp;
 		strobj = typ->strobj;
-		if ((strobj != NIL && strobj->name[0] != 0x00)) {
-			OPT_FPrintName(&idfp, (void*)OPT_GlbMod[__X(typ->mno, 64)]->name, 256);
-			OPT_FPrintName(&idfp, (void*)strobj->name, 256);
+		if ((strobj != NIL && (strobj->name->data)[0] != 0x00)) {
+			OPT_FPrintName(&idfp, (void*)OPT_GlbMod[__X(typ->mno, 64)]->name->data, OPT_GlbMod[__X(typ->mno, 64)]->name->len[0]);
+			OPT_FPrintName(&idfp, (void*)strobj->name->data, strobj->name->len[0]);
 		}
 		if ((f == 11 || (c == 4 && btyp != NIL)) || c == 3) {
 			OPT_IdFPrint(btyp);
@@ -718,7 +911,7 @@ static void FPrintHdFld__18 (OPT_Struct typ, OPT_Object fld, INT32 adr)
 				}
 			}
 		}
-	} else if (typ->form == 11 || __STRCMP(fld->name, "@ptr") == 0) {
+	} else if (typ->form == 11 || __STRCMP(fld->name->data, "@ptr") == 0) {
 		OPM_FPrint(&*FPrintStr__15_s->pvfp, 11);
 		OPM_FPrint(&*FPrintStr__15_s->pvfp, adr);
 		OPT_nofhdfld += 1;
@@ -730,7 +923,7 @@ static void FPrintFlds__16 (OPT_Object fld, INT32 adr, BOOLEAN visible)
 	while ((fld != NIL && fld->mode == 4)) {
 		if ((fld->vis != 0 && visible)) {
 			OPM_FPrint(&*FPrintStr__15_s->pbfp, fld->vis);
-			OPT_FPrintName(&*FPrintStr__15_s->pbfp, (void*)fld->name, 256);
+			OPT_FPrintName(&*FPrintStr__15_s->pbfp, (void*)fld->name->data, fld->name->len[0]);
 			OPM_FPrint(&*FPrintStr__15_s->pbfp, fld->adr);
 			OPT_FPrintStr(fld->typ);
 			OPM_FPrint(&*FPrintStr__15_s->pbfp, fld->typ->pbfp);
@@ -751,7 +944,7 @@ static void FPrintTProcs__20 (OPT_Object obj)
 				OPM_FPrint(&*FPrintStr__15_s->pbfp, 13);
 				OPM_FPrint(&*FPrintStr__15_s->pbfp, __ASHR(obj->adr, 16));
 				OPT_FPrintSign(&*FPrintStr__15_s->pbfp, obj->typ, obj->link);
-				OPT_FPrintName(&*FPrintStr__15_s->pbfp, (void*)obj->name, 256);
+				OPT_FPrintName(&*FPrintStr__15_s->pbfp, (void*)obj->name->data, obj->name->len[0]);
 			}
 		}
 		FPrintTProcs__20(obj->right);
@@ -785,7 +978,7 @@ void OPT_FPrintStr (OPT_Struct typ)
 		if (f == 11) {
 			strobj = typ->strobj;
 			bstrobj = btyp->strobj;
-			if (((strobj == NIL || strobj->name[0] == 0x00) || bstrobj == NIL) || bstrobj->name[0] == 0x00) {
+			if (((strobj == NIL || (strobj->name->data)[0] == 0x00) || bstrobj == NIL) || (bstrobj->name->data)[0] == 0x00) {
 				OPT_FPrintStr(btyp);
 				OPM_FPrint(&pbfp, btyp->pbfp);
 				pvfp = pbfp;
@@ -812,7 +1005,7 @@ void OPT_FPrintStr (OPT_Struct typ)
 			FPrintTProcs__20(typ->link);
 			OPM_FPrint(&pvfp, pbfp);
 			strobj = typ->strobj;
-			if (strobj == NIL || strobj->name[0] == 0x00) {
+			if (strobj == NIL || (strobj->name->data)[0] == 0x00) {
 				pbfp = pvfp;
 			}
 		}
@@ -887,7 +1080,7 @@ void OPT_FPrintErr (OPT_Object obj, INT16 errcode)
 	INT16 i, j;
 	CHAR ch;
 	if (obj->mnolev != 0) {
-		__COPY(OPT_GlbMod[__X(-obj->mnolev, 64)]->name, OPM_objname, 64);
+		__COPY(OPT_GlbMod[__X(-obj->mnolev, 64)]->name->data, OPM_objname, 64);
 		i = 0;
 		while (OPM_objname[__X(i, 64)] != 0x00) {
 			i += 1;
@@ -896,13 +1089,13 @@ void OPT_FPrintErr (OPT_Object obj, INT16 errcode)
 		j = 0;
 		i += 1;
 		do {
-			ch = obj->name[__X(j, 256)];
+			ch = (obj->name->data)[__X(j, obj->name->len[0])];
 			OPM_objname[__X(i, 64)] = ch;
 			j += 1;
 			i += 1;
 		} while (!(ch == 0x00));
 	} else {
-		__COPY(obj->name, OPM_objname, 64);
+		__COPY(obj->name->data, OPM_objname, 64);
 	}
 	if (errcode == 249) {
 		if (OPM_noerr) {
@@ -923,53 +1116,60 @@ void OPT_FPrintErr (OPT_Object obj, INT16 errcode)
 
 void OPT_InsertImport (OPT_Object obj, OPT_Object *root, OPT_Object *old)
 {
-	OPT_Object ob0 = NIL, ob1 = NIL;
-	BOOLEAN left;
+	OPT_InsertScope(obj, root, &*old);
+}
+
+static void OPT_InsertTreap (OPT_Object obj, INT32 prio, OPT_Object *root, OPT_Object *old)
+{
+	OPT_Object t = NIL;
+	if (*root == NIL) {
+		obj->left = NIL;
+		obj->right = NIL;
+		*root = obj;
+		*old = NIL;
+	} else if (__STRCMP(obj->name->data, (*root)->name->data) < 0) {
+		OPT_InsertTreap(obj, prio, &(*root)->left, &*old);
+		t = (*root)->left;
+		if ((t == obj && prio > (*root)->hash)) {
+			(*root)->left = t->right;
+			t->right = *root;
+			*root = t;
+		}
+	} else if (__STRCMP(obj->name->data, (*root)->name->data) > 0) {
+		OPT_InsertTreap(obj, prio, &(*root)->right, &*old);
+		t = (*root)->right;
+		if ((t == obj && prio > (*root)->hash)) {
+			(*root)->right = t->left;
+			t->left = *root;
+			*root = t;
+		}
+	} else {
+		*old = *root;
+	}
+}
+
+static void OPT_InsertScope (OPT_Object obj, OPT_Object *root, OPT_Object *old)
+{
+	INT32 hash;
+	hash = OPS_HashOf((void*)obj->name->data, obj->name->len[0]);
 	if (*root == NIL) {
+		obj->left = NIL;
+		obj->right = NIL;
 		*root = obj;
 		*old = NIL;
 	} else {
-		ob0 = *root;
-		ob1 = ob0->right;
-		left = 0;
-		if (__STRCMP(obj->name, ob0->name) < 0) {
-			ob1 = ob0->left;
-			left = 1;
-		} else if (__STRCMP(obj->name, ob0->name) > 0) {
-			ob1 = ob0->right;
-			left = 0;
+		if (__STRCMP(obj->name->data, (*root)->name->data) < 0) {
+			OPT_InsertTreap(obj, hash, &(*root)->left, &*old);
+		} else if (__STRCMP(obj->name->data, (*root)->name->data) > 0) {
+			OPT_InsertTreap(obj, hash, &(*root)->right, &*old);
 		} else {
-			*old = ob0;
-			return;
+			*old = *root;
 		}
-		for (;;) {
-			if (ob1 != NIL) {
-				if (__STRCMP(obj->name, ob1->name) < 0) {
-					ob0 = ob1;
-					ob1 = ob1->left;
-					left = 1;
-				} else if (__STRCMP(obj->name, ob1->name) > 0) {
-					ob0 = ob1;
-					ob1 = ob1->right;
-					left = 0;
-				} else {
-					*old = ob1;
-					break;
-				}
-			} else {
-				ob1 = obj;
-				if (left) {
-					ob0->left = ob1;
-				} else {
-					ob0->right = ob1;
-				}
-				ob1->left = NIL;
-				ob1->right = NIL;
-				*old = NIL;
-				break;
-			}
+		if (*old != NIL) {
+			return;
 		}
 	}
+	OPT_IndexObj(*root, obj, hash);
 }
 
 static void OPT_InName (CHAR *name, ADDRESS name__len)
@@ -984,44 +1184,38 @@ static void OPT_InName (CHAR *name, ADDRESS name__len)
 	} while (!(ch == 0x00));
 }
 
-static void OPT_InMod (INT8 *mno)
+static void OPT_InMod (OPM_SymFile sf, INT8 *mno)
 {
 	OPT_Object head = NIL;
 	OPS_Name name;
-	INT32 mn;
 	INT8 i;
-	mn = OPM_SymRInt();
-	if (mn == 0) {
-		*mno = OPT_impCtxt.glbmno[0];
+	INT32 pos;
+	OPT_InName((void*)name, 256);
+	if ((__STRCMP(name, OPT_SelfName) == 0 && !OPT_impCtxt.self)) {
+		OPT_err(154);
+	}
+	i = 0;
+	while ((i < OPT_nofGmod && __STRCMP(name, OPT_GlbMod[__X(i, 64)]->name->data) != 0)) {
+		i += 1;
+	}
+	if ((i == OPT_nofGmod && OPT_splicing)) {
+		pos = OPM_SymPos();
+		OPT_Splice((void*)name, 256);
+		OPM_SymSelect(sf, pos);
+	}
+	if (i < OPT_nofGmod) {
+		*mno = i;
 	} else {
-		if (mn == 16) {
-			OPT_InName((void*)name, 256);
-			if ((__STRCMP(name, OPT_SelfName) == 0 && !OPT_impCtxt.self)) {
-				OPT_err(154);
-			}
-			i = 0;
-			while ((i < OPT_nofGmod && __STRCMP(name, OPT_GlbMod[__X(i, 64)]->name) != 0)) {
-				i += 1;
-			}
-			if (i < OPT_nofGmod) {
-				*mno = i;
-			} else {
-				head = OPT_NewObj();
-				head->mode = 12;
-				__COPY(name, head->name, 256);
-				*mno = OPT_nofGmod;
-				head->mnolev = -*mno;
-				if (OPT_nofGmod < 64) {
-					OPT_GlbMod[__X(*mno, 64)] = head;
-					OPT_nofGmod += 1;
-				} else {
-					OPT_err(227);
-				}
-			}
-			OPT_impCtxt.glbmno[__X(OPT_impCtxt.nofm, 64)] = *mno;
-			OPT_impCtxt.nofm += 1;
+		head = OPT_NewObj();
+		head->mode = 12;
+		head->name = OPS_Intern(name, 256);
+		*mno = OPT_nofGmod;
+		head->mnolev = -*mno;
+		if (OPT_nofGmod < 64) {
+			OPT_GlbMod[__X(*mno, 64)] = head;
+			OPT_nofGmod += 1;
 		} else {
-			*mno = OPT_impCtxt.glbmno[__X(-mn, 64)];
+			OPT_err(227);
 		}
 	}
 }
@@ -1099,6 +1293,7 @@ static void OPT_InSign (INT8 mno, OPT_Struct *res, OPT_Object *par)
 {
 	OPT_Object last = NIL, new = NIL;
 	INT32 tag;
+	OPS_Name name;
 	OPT_InStruct(&*res);
 	tag = OPM_SymRInt();
 	last = NIL;
@@ -1117,7 +1312,8 @@ static void OPT_InSign (INT8 mno, OPT_Struct *res, OPT_Object *par)
 		}
 		OPT_InStruct(&new->typ);
 		new->adr = OPM_SymRInt();
-		OPT_InName((void*)new->name, 256);
+		OPT_InName((void*)name, 256);
+		new->name = OPS_Intern(name, 256);
 		last = new;
 		tag = OPM_SymRInt();
 	}
@@ -1127,6 +1323,7 @@ static OPT_Object OPT_InFld (void)
 {
 	INT32 tag;
 	OPT_Object obj = NIL;
+	OPS_Name name;
 	tag = OPT_impCtxt.nextTag;
 	obj = OPT_NewObj();
 	if (tag <= 26) {
@@ -1137,14 +1334,15 @@ static OPT_Object OPT_InFld (void)
 			obj->vis = 1;
 		}
 		OPT_InStruct(&obj->typ);
-		OPT_InName((void*)obj->name, 256);
+		OPT_InName((void*)name, 256);
+		obj->name = OPS_Intern(name, 256);
 		obj->adr = OPM_SymRInt();
 	} else {
 		obj->mode = 4;
 		if (tag == 27) {
-			__MOVE("@ptr", obj->name, 5);
+			obj->name = OPS_Intern((CHAR*)"@ptr", 5);
 		} else {
-			__MOVE("@proc", obj->name, 6);
+			obj->name = OPS_Intern((CHAR*)"@proc", 6);
 		}
 		obj->typ = OPT_undftyp;
 		obj->vis = 0;
@@ -1157,6 +1355,7 @@ static OPT_Object OPT_InTProc (INT8 mno)
 {
 	INT32 tag;
 	OPT_Object obj = NIL;
+	OPS_Name name;
 	tag = OPT_impCtxt.nextTag;
 	obj = OPT_NewObj();
 	obj->mnolev = -mno;
@@ -1166,11 +1365,12 @@ static OPT_Object OPT_InTProc (INT8 mno)
 		obj->conval->intval = -1;
 		OPT_InSign(mno, &obj->typ, &obj->link);
 		obj->vis = 1;
-		OPT_InName((void*)obj->name, 256);
+		OPT_InName((void*)name, 256);
+		obj->name = OPS_Intern(name, 256);
 		obj->adr = __ASHL(OPM_SymRInt(), 16);
 	} else {
 		obj->mode = 13;
-		__MOVE("@tproc", obj->name, 7);
+		obj->name = OPS_Intern((CHAR*)"@tproc", 7);
 		obj->link = OPT_NewObj();
 		obj->typ = OPT_undftyp;
 		obj->vis = 0;
@@ -1185,203 +1385,215 @@ static OPT_Struct OPT_InTyp (INT32 tag)
 		return OPT_IntType(OPM_SymRInt());
 	} else if (tag == 7) {
 		return OPT_SetType(OPM_SymRInt());
+	} else if (tag < 14) {
+		return OPT_impCtxt.ref[__X(tag, 14)];
 	} else {
-		return OPT_impCtxt.ref[__X(tag, 255)];
+		return OPT_InRef(tag);
 	}
 	__RETCHK;
 }
 
 static void OPT_InStruct (OPT_Struct *typ)
 {
+	*typ = OPT_InTyp(-OPM_SymRInt());
+}
+
+static OPT_Struct OPT_InRef (INT32 ref)
+{
+	OPT_SymMod sm = NIL;
 	INT8 mno;
-	INT16 ref;
-	INT32 tag;
+	INT32 pos, tag, p, r;
 	OPS_Name name;
-	OPT_Struct t = NIL;
+	OPT_Struct typ = NIL, t = NIL;
 	OPT_Object obj = NIL, last = NIL, fld = NIL, old = NIL, dummy = NIL;
+	sm = OPT_impCtxt.sm;
+	if (sm->ref->data[__X(ref, sm->ref->len[0])] != NIL) {
+		return sm->ref->data[__X(ref, sm->ref->len[0])];
+	}
+	pos = OPM_SymPos();
+	OPM_SymSelect(sm->sf, sm->strTab + __ASHL(ref - 14, 2));
+	OPM_SymSelect(sm->sf, OPM_SymRLInt());
+	OPT_impCtxt.pending[__X(OPT_impCtxt.nofp, 255)] = ref;
+	OPT_impCtxt.nofp += 1;
+	OPT_impCtxt.depth += 1;
 	tag = OPM_SymRInt();
-	if (tag != 34) {
-		*typ = OPT_InTyp(-tag);
+	mno = sm->glbmno[__X(tag, 64)];
+	OPT_InName((void*)name, 256);
+	obj = OPT_NewObj();
+	typ = OPT_NewStr(0, 1);
+	t = typ;
+	if (name[0] == 0x00) {
+		if (!OPT_impCtxt.self) {
+			obj->name = OPS_Intern((CHAR*)"@", 2);
+			OPT_InsertScope(obj, &OPT_GlbMod[__X(mno, 64)]->right, &old);
+			obj->name = OPS_Intern((CHAR*)"", 1);
+		}
 	} else {
-		ref = OPT_impCtxt.nofr;
-		OPT_impCtxt.nofr += 1;
-		if (ref < OPT_impCtxt.minr) {
-			OPT_impCtxt.minr = ref;
+		obj->name = OPS_Intern(name, 256);
+		OPT_InsertScope(obj, &OPT_GlbMod[__X(mno, 64)]->right, &old);
+		if (old != NIL) {
+			OPT_FPrintObj(old);
+			sm->pvfp->data[__X(ref, sm->pvfp->len[0])] = old->typ->pvfp;
+			if (!OPT_impCtxt.self) {
+				t = old->typ;
+			}
 		}
-		OPT_InMod(&mno);
-		OPT_InName((void*)name, 256);
-		obj = OPT_NewObj();
-		if (name[0] == 0x00) {
-			if (OPT_impCtxt.self) {
-				old = NIL;
+	}
+	sm->ref->data[__X(ref, sm->ref->len[0])] = t;
+	sm->str->data[__X(ref, sm->str->len[0])] = typ;
+	sm->old->data[__X(ref, sm->old->len[0])] = old;
+	typ->ref = ref + 255;
+	typ->mno = mno;
+	typ->allocated = 1;
+	typ->strobj = obj;
+	obj->mode = 5;
+	obj->typ = typ;
+	obj->mnolev = -mno;
+	obj->vis = 0;
+	tag = OPM_SymRInt();
+	if (tag == 35) {
+		typ->sysflag = __SHORTF(OPM_SymRInt(), 32768);
+		tag = OPM_SymRInt();
+	}
+	switch (tag) {
+		case 36: 
+			typ->form = 11;
+			typ->size = OPM_AddressSize;
+			typ->n = 0;
+			OPT_InStruct(&typ->BaseTyp);
+			break;
+		case 37: 
+			typ->form = 13;
+			typ->comp = 2;
+			OPT_InStruct(&typ->BaseTyp);
+			typ->n = OPM_SymRInt();
+			OPT_TypSize(typ);
+			break;
+		case 38: 
+			typ->form = 13;
+			typ->comp = 3;
+			OPT_InStruct(&typ->BaseTyp);
+			if (typ->BaseTyp->comp == 3) {
+				typ->n = typ->BaseTyp->n + 1;
 			} else {
-				__MOVE("@", obj->name, 2);
-				OPT_InsertImport(obj, &OPT_GlbMod[__X(mno, 64)]->right, &old);
-				obj->name[0] = 0x00;
+				typ->n = 0;
 			}
-			*typ = OPT_NewStr(0, 1);
-		} else {
-			__MOVE(name, obj->name, 256);
-			OPT_InsertImport(obj, &OPT_GlbMod[__X(mno, 64)]->right, &old);
-			if (old != NIL) {
-				OPT_FPrintObj(old);
-				OPT_impCtxt.pvfp[__X(ref, 255)] = old->typ->pvfp;
-				if (OPT_impCtxt.self) {
-					*typ = OPT_NewStr(0, 1);
-				} else {
-					*typ = old->typ;
-					(*typ)->link = NIL;
-					(*typ)->sysflag = 0;
-					(*typ)->fpdone = 0;
-					(*typ)->idfpdone = 0;
-				}
-			} else {
-				*typ = OPT_NewStr(0, 1);
+			OPT_TypSize(typ);
+			break;
+		case 39: 
+			typ->form = 13;
+			typ->comp = 4;
+			OPT_InStruct(&typ->BaseTyp);
+			if (typ->BaseTyp == OPT_notyp) {
+				typ->BaseTyp = NIL;
 			}
-		}
-		OPT_impCtxt.ref[__X(ref, 255)] = *typ;
-		OPT_impCtxt.old[__X(ref, 255)] = old;
-		(*typ)->ref = ref + 255;
-		(*typ)->mno = mno;
-		(*typ)->allocated = 1;
-		(*typ)->strobj = obj;
-		obj->mode = 5;
-		obj->typ = *typ;
-		obj->mnolev = -mno;
-		obj->vis = 0;
-		tag = OPM_SymRInt();
-		if (tag == 35) {
-			(*typ)->sysflag = __SHORTF(OPM_SymRInt(), 32768);
-			tag = OPM_SymRInt();
-		}
-		switch (tag) {
-			case 36: 
-				(*typ)->form = 11;
-				(*typ)->size = OPM_AddressSize;
-				(*typ)->n = 0;
-				OPT_InStruct(&(*typ)->BaseTyp);
-				break;
-			case 37: 
-				(*typ)->form = 13;
-				(*typ)->comp = 2;
-				OPT_InStruct(&(*typ)->BaseTyp);
-				(*typ)->n = OPM_SymRInt();
-				OPT_TypSize(*typ);
-				break;
-			case 38: 
-				(*typ)->form = 13;
-				(*typ)->comp = 3;
-				OPT_InStruct(&(*typ)->BaseTyp);
-				if ((*typ)->BaseTyp->comp == 3) {
-					(*typ)->n = (*typ)->BaseTyp->n + 1;
-				} else {
-					(*typ)->n = 0;
-				}
-				OPT_TypSize(*typ);
-				break;
-			case 39: 
-				(*typ)->form = 13;
-				(*typ)->comp = 4;
-				OPT_InStruct(&(*typ)->BaseTyp);
-				if ((*typ)->BaseTyp == OPT_notyp) {
-					(*typ)->BaseTyp = NIL;
-				}
-				(*typ)->extlev = 0;
-				t = (*typ)->BaseTyp;
-				while (t != NIL) {
-					(*typ)->extlev += 1;
-					t = t->BaseTyp;
+			typ->extlev = 0;
+			t = typ->BaseTyp;
+			while (t != NIL) {
+				typ->extlev += 1;
+				t = t->BaseTyp;
+			}
+			typ->size = OPM_SymRInt();
+			typ->align = OPM_SymRInt();
+			typ->n = OPM_SymRInt();
+			OPT_impCtxt.nextTag = OPM_SymRInt();
+			last = NIL;
+			while ((OPT_impCtxt.nextTag >= 25 && OPT_impCtxt.nextTag <= 28)) {
+				fld = OPT_InFld();
+				fld->mnolev = -mno;
+				if (last != NIL) {
+					last->link = fld;
 				}
-				(*typ)->size = OPM_SymRInt();
-				(*typ)->align = OPM_SymRInt();
-				(*typ)->n = OPM_SymRInt();
+				last = fld;
+				OPT_InsertImport(fld, &typ->link, &dummy);
 				OPT_impCtxt.nextTag = OPM_SymRInt();
-				last = NIL;
-				while ((OPT_impCtxt.nextTag >= 25 && OPT_impCtxt.nextTag <= 28)) {
-					fld = OPT_InFld();
-					fld->mnolev = -mno;
-					if (last != NIL) {
-						last->link = fld;
-					}
-					last = fld;
-					OPT_InsertImport(fld, &(*typ)->link, &dummy);
-					OPT_impCtxt.nextTag = OPM_SymRInt();
-				}
-				while (OPT_impCtxt.nextTag != 18) {
-					fld = OPT_InTProc(mno);
-					OPT_InsertImport(fld, &(*typ)->link, &dummy);
-					OPT_impCtxt.nextTag = OPM_SymRInt();
-				}
-				break;
-			case 40: 
-				(*typ)->form = 12;
-				(*typ)->size = OPM_AddressSize;
-				OPT_InSign(mno, &(*typ)->BaseTyp, &(*typ)->link);
-				break;
-			default: 
-				OPM_LogWStr((CHAR*)"unhandled case at InStruct, tag = ", 35);
-				OPM_LogWNum(tag, 0);
-				OPM_LogWLn();
-				break;
-		}
-		if (ref == OPT_impCtxt.minr) {
-			while (ref < OPT_impCtxt.nofr) {
-				t = OPT_InTyp(ref);
-				OPT_FPrintStr(t);
-				obj = t->strobj;
-				if (obj->name[0] != 0x00) {
-					OPT_FPrintObj(obj);
-				}
-				old = OPT_impCtxt.old[__X(ref, 255)];
-				if (old != NIL) {
-					t->strobj = old;
-					if (OPT_impCtxt.self) {
-						if (old->mnolev < 0) {
-							if (old->history != 5) {
-								if (old->fprint != obj->fprint) {
-									old->history = 2;
-								} else if (OPT_impCtxt.pvfp[__X(ref, 255)] != t->pvfp) {
-									old->history = 3;
-								}
+			}
+			while (OPT_impCtxt.nextTag != 18) {
+				fld = OPT_InTProc(mno);
+				OPT_InsertImport(fld, &typ->link, &dummy);
+				OPT_impCtxt.nextTag = OPM_SymRInt();
+			}
+			break;
+		case 40: 
+			typ->form = 12;
+			typ->size = OPM_AddressSize;
+			OPT_InSign(mno, &typ->BaseTyp, &typ->link);
+			break;
+		default: 
+			OPM_LogWStr((CHAR*)"unhandled case at InStruct, tag = ", 35);
+			OPM_LogWNum(tag, 0);
+			OPM_LogWLn();
+			break;
+	}
+	OPT_impCtxt.depth -= 1;
+	if (OPT_impCtxt.depth == 0) {
+		p = 0;
+		while (p < OPT_impCtxt.nofp) {
+			r = OPT_impCtxt.pending[__X(p, 255)];
+			t = sm->str->data[__X(r, sm->str->len[0])];
+			OPT_FPrintStr(t);
+			obj = t->strobj;
+			if ((obj->name->data)[0] != 0x00) {
+				OPT_FPrintObj(obj);
+			}
+			old = sm->old->data[__X(r, sm->old->len[0])];
+			if (old != NIL) {
+				t->strobj = old;
+				if (OPT_impCtxt.self) {
+					if (old->mnolev < 0) {
+						if (old->history != 5) {
+							if (old->fprint != obj->fprint) {
+								old->history = 2;
+							} else if (sm->pvfp->data[__X(r, sm->pvfp->len[0])] != t->pvfp) {
+								old->history = 3;
 							}
-						} else if (old->fprint != obj->fprint) {
-							old->history = 2;
-						} else if (OPT_impCtxt.pvfp[__X(ref, 255)] != t->pvfp) {
-							old->history = 3;
-						} else if (old->vis == 0) {
-							old->history = 1;
-						} else {
-							old->history = 0;
 						}
+					} else if (old->fprint != obj->fprint) {
+						old->history = 2;
+					} else if (sm->pvfp->data[__X(r, sm->pvfp->len[0])] != t->pvfp) {
+						old->history = 3;
+					} else if (old->vis == 0) {
+						old->history = 1;
 					} else {
-						if (OPT_impCtxt.pvfp[__X(ref, 255)] != t->pvfp) {
-							old->history = 5;
-						}
-						if (old->fprint != obj->fprint) {
-							OPT_FPrintErr(old, 249);
-						}
+						old->history = 0;
 					}
-				} else if (OPT_impCtxt.self) {
-					obj->history = 4;
 				} else {
-					obj->history = 1;
+					if (sm->pvfp->data[__X(r, sm->pvfp->len[0])] != t->pvfp) {
+						old->history = 5;
+					}
+					if (old->fprint != obj->fprint) {
+						OPT_FPrintErr(old, 249);
+					}
 				}
-				ref += 1;
+			} else if (OPT_impCtxt.self) {
+				obj->history = 4;
+			} else {
+				obj->history = 1;
 			}
-			OPT_impCtxt.minr = 255;
+			p += 1;
 		}
+		OPT_impCtxt.nofp = 0;
 	}
+	OPM_SymSelect(sm->sf, pos);
+	return sm->ref->data[__X(ref, sm->ref->len[0])];
 }
 
-static OPT_Object OPT_InObj (INT8 mno)
+static OPT_Object OPT_InObj (OPT_SymMod sm, INT32 k)
 {
 	INT16 i, s;
+	INT8 mno;
 	CHAR ch;
 	OPT_Object obj = NIL, old = NIL;
 	OPT_Struct typ = NIL;
 	INT32 tag;
 	OPT_ConstExt ext = NIL;
-	tag = OPT_impCtxt.nextTag;
+	OPS_Name name;
+	OPT_impCtxt.sm = sm;
+	mno = sm->glbmno[0];
+	OPM_SymSelect(sm->sf, sm->objTab + __ASHL(k, 3));
+	OPM_SymSelect(sm->sf, OPM_SymRLInt());
+	OPT_InName((void*)name, 256);
+	tag = OPM_SymRInt();
 	if (tag == 19) {
 		OPT_InStruct(&typ);
 		obj = typ->strobj;
@@ -1436,14 +1648,14 @@ static OPT_Object OPT_InObj (INT8 mno)
 			}
 			OPT_InStruct(&obj->typ);
 		}
-		OPT_InName((void*)obj->name, 256);
+		obj->name = OPS_Intern(name, 256);
 	}
 	OPT_FPrintObj(obj);
-	if ((obj->mode == 1 && (obj->typ->strobj == NIL || obj->typ->strobj->name[0] == 0x00))) {
+	if ((obj->mode == 1 && (obj->typ->strobj == NIL || (obj->typ->strobj->name->data)[0] == 0x00))) {
 		OPM_FPrint(&OPT_impCtxt.reffp, obj->typ->ref - 255);
 	}
 	if (tag != 19) {
-		OPT_InsertImport(obj, &OPT_GlbMod[__X(mno, 64)]->right, &old);
+		OPT_InsertScope(obj, &OPT_GlbMod[__X(mno, 64)]->right, &old);
 		if (OPT_impCtxt.self) {
 			if (old != NIL) {
 				if (old->vis == 0) {
@@ -1474,10 +1686,43 @@ static OPT_Object OPT_InObj (INT8 mno)
 	return obj;
 }
 
+static OPT_SymMod OPT_InHeader (OPM_SymFile sf)
+{
+	OPT_SymMod sm = NIL;
+	INT32 modPos, nofm, linkPos, k;
+	__NEW(sm, OPT_SymModDesc);
+	sm->sf = sf;
+	modPos = OPM_SymRLInt();
+	nofm = OPM_SymRLInt();
+	linkPos = OPM_SymRLInt();
+	sm->strTab = OPM_SymRLInt();
+	sm->nofStrs = OPM_SymRLInt();
+	sm->objTab = OPM_SymRLInt();
+	sm->nofObjs = OPM_SymRLInt();
+	sm->hashTab = OPM_SymRLInt();
+	sm->hashSize = OPM_SymRLInt();
+	OPM_SymSelect(sf, modPos);
+	k = 0;
+	while (k < nofm) {
+		OPT_InMod(sf, &sm->glbmno[__X(k, 64)]);
+		k += 1;
+	}
+	OPM_SymSelect(sf, linkPos);
+	OPT_InLinks();
+	sm->ref = __NEWARR(POINTER__typ, 4, 4, 1, 1, ((ADDRESS)(sm->nofStrs + 14)));
+	sm->str = __NEWARR(POINTER__typ, 4, 4, 1, 1, ((ADDRESS)(sm->nofStrs + 14)));
+	sm->old = __NEWARR(POINTER__typ, 4, 4, 1, 1, ((ADDRESS)(sm->nofStrs + 14)));
+	sm->pvfp = __NEWARR(NIL, 4, 4, 1, 1, ((ADDRESS)(sm->nofStrs + 14)));
+	return sm;
+}
+
 void OPT_Import (OPS_Name aliasName, OPS_Name name, BOOLEAN *done)
 {
 	OPT_Object obj = NIL;
+	OPT_SymMod sm = NIL;
+	OPM_SymFile sf = NIL;
 	INT8 mno;
+	INT32 k;
 	OPS_Name aliasName__copy;
 	__DUPARR(aliasName, OPS_Name);
 	if (__STRCMP(name, "SYSTEM") == 0) {
@@ -1488,24 +1733,29 @@ void OPT_Import (OPS_Name aliasName, OPS_Name name, BOOLEAN *done)
 		obj->scope = OPT_syslink;
 		obj->typ = OPT_notyp;
 	} else {
-		OPT_impCtxt.nofr = 14;
-		OPT_impCtxt.minr = 255;
-		OPT_impCtxt.nofm = 0;
+		OPM_StartPhase(1);
+		OPT_impCtxt.nofp = 0;
+		OPT_impCtxt.depth = 0;
 		OPT_impCtxt.self = __STRCMP(aliasName, "@self") == 0;
 		OPT_impCtxt.reffp = 0;
 		if ((OPT_impCtxt.self && __IN(17, OPM_Options, 32))) {
 			OPM_DeleteSym((void*)name, 256);
-			*done = 0;
 		} else {
-			OPM_OldSym((void*)name, 256, &*done);
+			OPM_OldSym((void*)name, 256, &sf);
 		}
+		*done = sf != NIL;
 		if (*done) {
-			OPT_InMod(&mno);
-			OPT_InLinks();
-			OPT_impCtxt.nextTag = OPM_SymRInt();
-			while (!OPM_eofSF()) {
-				obj = OPT_InObj(mno);
-				OPT_impCtxt.nextTag = OPM_SymRInt();
+			sm = OPT_InHeader(sf);
+			mno = sm->glbmno[0];
+			if (OPT_impCtxt.self) {
+				k = 0;
+				while (k < sm->nofObjs) {
+					obj = OPT_InObj(sm, k);
+					OPT_nofImported += 1;
+					k += 1;
+				}
+			} else if (!__IN(mno, OPT_spliced, 64)) {
+				OPT_symMods[__X(mno, 64)] = sm;
 			}
 			OPT_Insert(aliasName, &obj);
 			obj->mode = 11;
@@ -1521,7 +1771,313 @@ void OPT_Import (OPS_Name aliasName, OPS_Name name, BOOLEAN *done)
 		} else {
 			OPT_err(152);
 		}
+		OPM_StopPhase(1);
+	}
+}
+
+static void OPT_RebaseList (OPT_Object par, INT8 s, INT8 m)
+{
+	while (par != NIL) {
+		if (par->mnolev == -s) {
+			par->mnolev = -m;
+		}
+		par = par->link;
+	}
+}
+
+static void OPT_RebaseFlds (OPT_Object fld, INT8 s, INT8 m)
+{
+	if (fld != NIL) {
+		OPT_RebaseFlds(fld->left, s, m);
+		if (fld->mnolev == -s) {
+			fld->mnolev = -m;
+		}
+		if (fld->mode == 13) {
+			OPT_RebaseList(fld->link, s, m);
+		}
+		OPT_RebaseFlds(fld->right, s, m);
+	}
+}
+
+static void OPT_Rebase (OPT_Object obj, INT8 s, INT8 m)
+{
+	OPT_Struct typ = NIL;
+	if (obj != NIL) {
+		OPT_Rebase(obj->left, s, m);
+		if (obj->mnolev == -s) {
+			obj->mnolev = -m;
+		}
+		if (__IN(obj->mode, 0x0680, 32)) {
+			OPT_RebaseList(obj->link, s, m);
+		} else if (obj->mode == 5) {
+			typ = obj->typ;
+			if ((typ->strobj == obj && typ->mno == s)) {
+				typ->mno = m;
+				if (typ->comp == 4) {
+					OPT_RebaseFlds(typ->link, s, m);
+				} else if (typ->form == 12) {
+					OPT_RebaseList(typ->link, s, m);
+				}
+			}
+		}
+		OPT_Rebase(obj->right, s, m);
+	}
+}
+
+static BOOLEAN OPT_CacheCurrent (INT8 s)
+{
+	OPM_SymFile sf = NIL;
+	Platform_FileIdentity identity;
+	INT32 len;
+	OPM_OldSym((void*)OPT_cacheMod[__X(s, 64)]->name->data, OPT_cacheMod[__X(s, 64)]->name->len[0], &sf);
+	if (sf == NIL) {
+		return 0;
+	}
+	OPM_SymStamp(sf, &identity, Platform_FileIdentity__typ, &len);
+	OPM_CloseOldSym();
+	return ((Platform_SameFile(identity, OPT_cacheId[__X(s, 64)]) && Platform_SameFileTime(identity, OPT_cacheId[__X(s, 64)]))) && len == OPT_cacheLen[__X(s, 64)];
+}
+
+static void OPT_Attach (INT8 s)
+{
+	OPT_Object head = NIL;
+	INT8 m;
+	head = OPT_cacheMod[__X(s, 64)];
+	m = OPT_nofGmod;
+	head->mnolev = -m;
+	head->link = NIL;
+	head->vis = 0;
+	OPT_Rebase(head->right, s, m);
+	OPT_IndexTree(head->right, head->right);
+	OPT_IndexTypes(head->right);
+	OPT_GlbMod[__X(m, 64)] = head;
+	OPT_nofGmod += 1;
+	OPT_spliced |= __SETOF(m, 64);
+}
+
+static void OPT_Splice (CHAR *name, ADDRESS name__len)
+{
+	INT8 s, i, j, n;
+	UINT64 need, more, absent;
+	BOOLEAN ok;
+	s = 1;
+	while ((s < OPT_nofCache && __STRCMP(OPT_cacheMod[__X(s, 64)]->name->data, name) != 0)) {
+		s += 1;
+	}
+	if (s >= OPT_nofCache) {
+		return;
+	}
+	more = __SETOF(s, 64);
+	do {
+		need = more;
+		i = 1;
+		while (i < OPT_nofCache) {
+			if (__IN(i, need, 64)) {
+				more |= OPT_cacheDeps[__X(i, 64)];
+			}
+			i += 1;
+		}
+	} while (!(more == need));
+	absent = 0x0;
+	n = OPT_nofGmod;
+	ok = 1;
+	i = 1;
+	while ((i < OPT_nofCache && ok)) {
+		if (__IN(i, need, 64)) {
+			j = 0;
+			while ((j < OPT_nofGmod && OPT_GlbMod[__X(j, 64)]->name != OPT_cacheMod[__X(i, 64)]->name)) {
+				j += 1;
+			}
+			if (j < OPT_nofGmod) {
+				ok = OPT_GlbMod[__X(j, 64)] == OPT_cacheMod[__X(i, 64)];
+			} else {
+				ok = OPT_CacheCurrent(i);
+				absent |= __SETOF(i, 64);
+				n += 1;
+			}
+		}
+		i += 1;
+	}
+	if ((ok && n <= 64)) {
+		OPT_Attach(s);
+		i = 1;
+		while (i < OPT_nofCache) {
+			if ((i != s && __IN(i, absent, 64))) {
+				OPT_Attach(i);
+			}
+			i += 1;
+		}
+	}
+}
+
+void OPT_UseCache (void)
+{
+	OPT_useCache = 1;
+}
+
+static INT8 OPT_Load (CHAR *name, ADDRESS name__len)
+{
+	OPM_SymFile sf = NIL;
+	OPT_SymMod sm = NIL;
+	OPT_Object obj = NIL;
+	INT8 mno;
+	INT32 nofm, k;
+	UINT64 deps;
+	OPM_OldSym((void*)name, name__len, &sf);
+	if (sf == NIL) {
+		return -1;
+	}
+	OPT_impCtxt.nofp = 0;
+	OPT_impCtxt.depth = 0;
+	OPT_impCtxt.self = 0;
+	OPT_impCtxt.reffp = 0;
+	sm = OPT_InHeader(sf);
+	mno = sm->glbmno[0];
+	k = 0;
+	while (k < sm->nofObjs) {
+		obj = OPT_InObj(sm, k);
+		k += 1;
+	}
+	OPM_SymStamp(sf, &OPT_cacheId[__X(mno, 64)], Platform_FileIdentity__typ, &OPT_cacheLen[__X(mno, 64)]);
+	OPM_SymSelect(sf, 2);
+	k = OPM_SymRLInt();
+	nofm = OPM_SymRLInt();
+	deps = 0x0;
+	k = 1;
+	while (k < nofm) {
+		deps |= __SETOF(sm->glbmno[__X(k, 64)], 64);
+		k += 1;
+	}
+	OPT_cacheDeps[__X(mno, 64)] = deps & ~__SETOF(mno, 64);
+	OPM_CloseOldSym();
+	return mno;
+}
+
+void OPT_Warm (CHAR *names, ADDRESS names__len)
+{
+	INT8 s, m, mno;
+	INT8 map[64];
+	UINT64 stale, more, loaded;
+	INT32 i, j;
+	OPS_Name name;
+	BOOLEAN config, ok;
+	config = ((OPT_cacheModel == OPM_Model[0] && OPT_cacheAdrSize == OPM_AddressSize)) && OPT_cacheAlign == OPM_Alignment;
+	stale = 0x0;
+	s = 1;
+	while (s < OPT_nofCache) {
+		if (!config || !OPT_CacheCurrent(s)) {
+			stale |= __SETOF(s, 64);
+		}
+		s += 1;
+	}
+	do {
+		more = stale;
+		s = 1;
+		while (s < OPT_nofCache) {
+			if ((OPT_cacheDeps[__X(s, 64)] & stale) != 0x0) {
+				stale |= __SETOF(s, 64);
+			}
+			s += 1;
+		}
+	} while (!(stale == more));
+	m = 1;
+	s = 1;
+	while (s < OPT_nofCache) {
+		if (!__IN(s, stale, 64)) {
+			map[__X(s, 64)] = m;
+			if (m != s) {
+				OPT_cacheMod[__X(m, 64)] = OPT_cacheMod[__X(s, 64)];
+				OPT_cacheMod[__X(m, 64)]->mnolev = -m;
+				OPT_Rebase(OPT_cacheMod[__X(m, 64)]->right, s, m);
+				OPT_cacheId[__X(m, 64)] = OPT_cacheId[__X(s, 64)];
+				OPT_cacheLen[__X(m, 64)] = OPT_cacheLen[__X(s, 64)];
+				OPT_cacheDeps[__X(m, 64)] = OPT_cacheDeps[__X(s, 64)];
+			}
+			m += 1;
+		}
+		s += 1;
+	}
+	s = 1;
+	while (s < m) {
+		more = 0x0;
+		i = 1;
+		while (i < OPT_nofCache) {
+			if (__IN(i, OPT_cacheDeps[__X(s, 64)], 64)) {
+				more |= __SETOF(map[__X(i, 64)], 64);
+			}
+			i += 1;
+		}
+		OPT_cacheDeps[__X(s, 64)] = more;
+		s += 1;
+	}
+	s = m;
+	while (s < OPT_nofCache) {
+		OPT_cacheMod[__X(s, 64)] = NIL;
+		s += 1;
+	}
+	OPT_nofCache = m;
+	OPT_warming = 1;
+	name[0] = 0x00;
+	OPT_Init(name, 0x0);
+	loaded = 0x01;
+	s = 1;
+	while (s < OPT_nofCache) {
+		OPT_GlbMod[__X(s, 64)] = OPT_cacheMod[__X(s, 64)];
+		loaded |= __SETOF(s, 64);
+		s += 1;
+	}
+	OPT_nofGmod = OPT_nofCache;
+	i = 0;
+	while ((i < names__len && names[__X(i, names__len)] != 0x00)) {
+		j = 0;
+		while ((i < names__len && names[__X(i, names__len)] != 0x00)) {
+			name[__X(j, 256)] = names[__X(i, names__len)];
+			i += 1;
+			j += 1;
+		}
+		name[__X(j, 256)] = 0x00;
+		i += 1;
+		m = 0;
+		while ((m < OPT_nofGmod && __STRCMP(OPT_GlbMod[__X(m, 64)]->name->data, name) != 0)) {
+			m += 1;
+		}
+		if (m == OPT_nofGmod) {
+			mno = OPT_Load((void*)name, 256);
+			if (mno > 0) {
+				loaded |= __SETOF(mno, 64);
+			}
+		}
 	}
+	ok = 1;
+	m = 1;
+	while ((m < OPT_nofGmod && ok)) {
+		if (!__IN(m, loaded, 64)) {
+			ok = OPT_Load((void*)OPT_GlbMod[__X(m, 64)]->name->data, OPT_GlbMod[__X(m, 64)]->name->len[0]) == m;
+			loaded |= __SETOF(m, 64);
+		}
+		m += 1;
+	}
+	if ((ok && OPM_noerr)) {
+		s = 1;
+		while (s < OPT_nofGmod) {
+			OPT_cacheMod[__X(s, 64)] = OPT_GlbMod[__X(s, 64)];
+			OPT_cacheMod[__X(s, 64)]->link = NIL;
+			s += 1;
+		}
+		OPT_nofCache = OPT_nofGmod;
+		OPT_cacheModel = OPM_Model[0];
+		OPT_cacheAdrSize = OPM_AddressSize;
+		OPT_cacheAlign = OPM_Alignment;
+	} else {
+		s = 0;
+		while (s < 64) {
+			OPT_cacheMod[__X(s, 64)] = NIL;
+			s += 1;
+		}
+		OPT_nofCache = 0;
+	}
+	OPT_Close();
+	OPT_warming = 0;
 }
 
 static void OPT_OutName (CHAR *name, ADDRESS name__len)
@@ -1539,13 +2095,11 @@ static void OPT_OutName (CHAR *name, ADDRESS name__len)
 static void OPT_OutMod (INT16 mno)
 {
 	if (OPT_expCtxt.locmno[__X(mno, 64)] < 0) {
-		OPM_SymWInt(16);
 		OPT_expCtxt.locmno[__X(mno, 64)] = OPT_expCtxt.nofm;
+		OPT_expCtxt.mods[__X(OPT_expCtxt.nofm, 64)] = __SHORT(mno, 128);
 		OPT_expCtxt.nofm += 1;
-		OPT_OutName((void*)OPT_GlbMod[__X(mno, 64)]->name, 256);
-	} else {
-		OPM_SymWInt(-OPT_expCtxt.locmno[__X(mno, 64)]);
 	}
+	OPM_SymWInt(OPT_expCtxt.locmno[__X(mno, 64)]);
 }
 
 static void OPT_OutLinks (void)
@@ -1584,7 +2138,7 @@ static void OPT_OutHdFld (OPT_Struct typ, OPT_Object fld, INT32 adr)
 				}
 			}
 		}
-	} else if (typ->form == 11 || __STRCMP(fld->name, "@ptr") == 0) {
+	} else if (typ->form == 11 || __STRCMP(fld->name->data, "@ptr") == 0) {
 		OPM_SymWInt(27);
 		OPM_SymWInt(adr);
 		OPT_nofhdfld += 1;
@@ -1601,7 +2155,7 @@ static void OPT_OutFlds (OPT_Object fld, INT32 adr, BOOLEAN visible)
 				OPM_SymWInt(25);
 			}
 			OPT_OutStr(fld->typ);
-			OPT_OutName((void*)fld->name, 256);
+			OPT_OutName((void*)fld->name->data, fld->name->len[0]);
 			OPM_SymWInt(fld->adr);
 		} else {
 			OPT_OutHdFld(fld->typ, fld, fld->adr + adr);
@@ -1621,7 +2175,7 @@ static void OPT_OutSign (OPT_Struct result, OPT_Object par)
 		}
 		OPT_OutStr(par->typ);
 		OPM_SymWInt(par->adr);
-		OPT_OutName((void*)par->name, 256);
+		OPT_OutName((void*)par->name->data, par->name->len[0]);
 		par = par->link;
 	}
 	OPM_SymWInt(18);
@@ -1639,7 +2193,7 @@ static void OPT_OutTProcs (OPT_Struct typ, OPT_Object obj)
 				if (obj->vis != 0) {
 					OPM_SymWInt(29);
 					OPT_OutSign(obj->typ, obj->link);
-					OPT_OutName((void*)obj->name, 256);
+					OPT_OutName((void*)obj->name->data, obj->name->len[0]);
 					OPM_SymWInt(__ASHR(obj->adr, 16));
 				} else {
 					OPM_SymWInt(30);
@@ -1652,95 +2206,99 @@ static void OPT_OutTProcs (OPT_Struct typ, OPT_Object obj)
 }
 
 static void OPT_OutStr (OPT_Struct typ)
+{
+	if (typ->ref >= OPT_expCtxt.ref) {
+		if (OPT_expCtxt.ref < 255) {
+			typ->ref = OPT_expCtxt.ref;
+			OPT_expCtxt.strs->data[__X(typ->ref, OPT_expCtxt.strs->len[0])] = typ;
+			OPT_expCtxt.ref += 1;
+		} else {
+			OPT_err(228);
+		}
+	}
+	OPM_SymWInt(-typ->ref);
+	if (__IN(typ->ref, 0x90, 32)) {
+		OPM_SymWInt(typ->size);
+	}
+}
+
+static void OPT_OutStrDef (OPT_Struct typ)
 {
 	OPT_Object strobj = NIL;
-	if (typ->ref < OPT_expCtxt.ref) {
-		OPM_SymWInt(-typ->ref);
-		if (__IN(typ->ref, 0x90, 32)) {
-			OPM_SymWInt(typ->size);
+	OPT_OutMod(typ->mno);
+	strobj = typ->strobj;
+	if ((strobj != NIL && (strobj->name->data)[0] != 0x00)) {
+		OPT_OutName((void*)strobj->name->data, strobj->name->len[0]);
+		switch (strobj->history) {
+			case 2: 
+				OPT_FPrintErr(strobj, 252);
+				break;
+			case 3: 
+				OPT_FPrintErr(strobj, 251);
+				break;
+			case 5: 
+				OPT_FPrintErr(strobj, 249);
+				break;
+			default: 
+				break;
 		}
 	} else {
-		OPM_SymWInt(34);
-		typ->ref = OPT_expCtxt.ref;
-		OPT_expCtxt.ref += 1;
-		if (OPT_expCtxt.ref >= 255) {
-			OPT_err(228);
-		}
-		OPT_OutMod(typ->mno);
-		strobj = typ->strobj;
-		if ((strobj != NIL && strobj->name[0] != 0x00)) {
-			OPT_OutName((void*)strobj->name, 256);
-			switch (strobj->history) {
+		OPM_SymWCh(0x00);
+	}
+	if (typ->sysflag != 0) {
+		OPM_SymWInt(35);
+		OPM_SymWInt(typ->sysflag);
+	}
+	switch (typ->form) {
+		case 11: 
+			OPM_SymWInt(36);
+			OPT_OutStr(typ->BaseTyp);
+			break;
+		case 12: 
+			OPM_SymWInt(40);
+			OPT_OutSign(typ->BaseTyp, typ->link);
+			break;
+		case 13: 
+			switch (typ->comp) {
 				case 2: 
-					OPT_FPrintErr(strobj, 252);
+					OPM_SymWInt(37);
+					OPT_OutStr(typ->BaseTyp);
+					OPM_SymWInt(typ->n);
 					break;
 				case 3: 
-					OPT_FPrintErr(strobj, 251);
+					OPM_SymWInt(38);
+					OPT_OutStr(typ->BaseTyp);
 					break;
-				case 5: 
-					OPT_FPrintErr(strobj, 249);
+				case 4: 
+					OPM_SymWInt(39);
+					if (typ->BaseTyp == NIL) {
+						OPT_OutStr(OPT_notyp);
+					} else {
+						OPT_OutStr(typ->BaseTyp);
+					}
+					OPM_SymWInt(typ->size);
+					OPM_SymWInt(typ->align);
+					OPM_SymWInt(typ->n);
+					OPT_nofhdfld = 0;
+					OPT_OutFlds(typ->link, 0, 1);
+					if (OPT_nofhdfld > 2048) {
+						OPM_Mark(223, typ->txtpos);
+					}
+					OPT_OutTProcs(typ, typ->link);
+					OPM_SymWInt(18);
 					break;
 				default: 
+					OPM_LogWStr((CHAR*)"unhandled case at OutStr, typ^.comp = ", 39);
+					OPM_LogWNum(typ->comp, 0);
+					OPM_LogWLn();
 					break;
 			}
-		} else {
-			OPM_SymWCh(0x00);
-		}
-		if (typ->sysflag != 0) {
-			OPM_SymWInt(35);
-			OPM_SymWInt(typ->sysflag);
-		}
-		switch (typ->form) {
-			case 11: 
-				OPM_SymWInt(36);
-				OPT_OutStr(typ->BaseTyp);
-				break;
-			case 12: 
-				OPM_SymWInt(40);
-				OPT_OutSign(typ->BaseTyp, typ->link);
-				break;
-			case 13: 
-				switch (typ->comp) {
-					case 2: 
-						OPM_SymWInt(37);
-						OPT_OutStr(typ->BaseTyp);
-						OPM_SymWInt(typ->n);
-						break;
-					case 3: 
-						OPM_SymWInt(38);
-						OPT_OutStr(typ->BaseTyp);
-						break;
-					case 4: 
-						OPM_SymWInt(39);
-						if (typ->BaseTyp == NIL) {
-							OPT_OutStr(OPT_notyp);
-						} else {
-							OPT_OutStr(typ->BaseTyp);
-						}
-						OPM_SymWInt(typ->size);
-						OPM_SymWInt(typ->align);
-						OPM_SymWInt(typ->n);
-						OPT_nofhdfld = 0;
-						OPT_OutFlds(typ->link, 0, 1);
-						if (OPT_nofhdfld > 2048) {
-							OPM_Mark(223, typ->txtpos);
-						}
-						OPT_OutTProcs(typ, typ->link);
-						OPM_SymWInt(18);
-						break;
-					default: 
-						OPM_LogWStr((CHAR*)"unhandled case at OutStr, typ^.comp = ", 39);
-						OPM_LogWNum(typ->comp, 0);
-						OPM_LogWLn();
-						break;
-				}
-				break;
-			default: 
-				OPM_LogWStr((CHAR*)"unhandled case at OutStr, typ^.form = ", 39);
-				OPM_LogWNum(typ->form, 0);
-				OPM_LogWLn();
-				break;
-		}
+			break;
+		default: 
+			OPM_LogWStr((CHAR*)"unhandled case at OutStr, typ^.form = ", 39);
+			OPM_LogWNum(typ->form, 0);
+			OPM_LogWLn();
+			break;
 	}
 }
 
@@ -1780,6 +2338,25 @@ static void OPT_OutConstant (OPT_Object obj)
 	}
 }
 
+static void OPT_OutEntry (OPT_Object obj)
+{
+	INT32 i;
+	struct {ADDRESS len[1]; INT32 data[1];} *old = NIL;
+	if (__ASHL(OPT_expCtxt.nofo, 1) >= OPT_expCtxt.objs->len[0]) {
+		old = (void*)OPT_expCtxt.objs;
+		OPT_expCtxt.objs = __NEWARR(NIL, 4, 4, 1, 1, ((ADDRESS)(2 * old->len[0])));
+		i = 0;
+		while (i < old->len[0]) {
+			OPT_expCtxt.objs->data[__X(i, OPT_expCtxt.objs->len[0])] = old->data[__X(i, old->len[0])];
+			i += 1;
+		}
+	}
+	OPT_expCtxt.objs->data[__X(__ASHL(OPT_expCtxt.nofo, 1), OPT_expCtxt.objs->len[0])] = OPM_SymWPos();
+	OPT_expCtxt.objs->data[__X(__ASHL(OPT_expCtxt.nofo, 1) + 1, OPT_expCtxt.objs->len[0])] = OPS_HashOf((void*)obj->name->data, obj->name->len[0]);
+	OPT_expCtxt.nofo += 1;
+	OPT_OutName((void*)obj->name->data, obj->name->len[0]);
+}
+
 static void OPT_OutObj (OPT_Object obj)
 {
 	INT16 i, j;
@@ -1808,10 +2385,10 @@ static void OPT_OutObj (OPT_Object obj)
 						OPM_LogWLn();
 						break;
 				}
+				OPT_OutEntry(obj);
 				switch (obj->mode) {
 					case 3: 
 						OPT_OutConstant(obj);
-						OPT_OutName((void*)obj->name, 256);
 						break;
 					case 5: 
 						if (obj->typ->strobj == obj) {
@@ -1820,8 +2397,7 @@ static void OPT_OutObj (OPT_Object obj)
 						} else {
 							OPM_SymWInt(20);
 							OPT_OutStr(obj->typ);
-							OPT_OutName((void*)obj->name, 256);
-						}
+							}
 						break;
 					case 1: 
 						if (obj->vis == 2) {
@@ -1830,20 +2406,17 @@ static void OPT_OutObj (OPT_Object obj)
 							OPM_SymWInt(21);
 						}
 						OPT_OutStr(obj->typ);
-						OPT_OutName((void*)obj->name, 256);
-						if (obj->typ->strobj == NIL || obj->typ->strobj->name[0] == 0x00) {
+						if (obj->typ->strobj == NIL || (obj->typ->strobj->name->data)[0] == 0x00) {
 							OPM_FPrint(&OPT_expCtxt.reffp, obj->typ->ref);
 						}
 						break;
 					case 7: 
 						OPM_SymWInt(31);
 						OPT_OutSign(obj->typ, obj->link);
-						OPT_OutName((void*)obj->name, 256);
 						break;
 					case 10: 
 						OPM_SymWInt(32);
 						OPT_OutSign(obj->typ, obj->link);
-						OPT_OutName((void*)obj->name, 256);
 						break;
 					case 9: 
 						OPM_SymWInt(33);
@@ -1856,7 +2429,6 @@ static void OPT_OutObj (OPT_Object obj)
 							OPM_SymWCh((*ext)[__X(i, 256)]);
 							i += 1;
 						}
-						OPT_OutName((void*)obj->name, 256);
 						break;
 					default: 
 						OPM_LogWStr((CHAR*)"unhandled case at OutObj, obj.mode = ", 38);
@@ -1875,6 +2447,8 @@ void OPT_Export (BOOLEAN *ext, BOOLEAN *new)
 	INT16 i;
 	INT8 nofmod;
 	BOOLEAN done;
+	INT32 k, slot, modPos, linkPos, strTab, objTab, hashTab, hashSize;
+	struct {ADDRESS len[1]; INT32 data[1];} *hash = NIL;
 	OPT_symExtended = 0;
 	OPT_symNew = 0;
 	nofmod = OPT_nofGmod;
@@ -1883,19 +2457,83 @@ void OPT_Export (BOOLEAN *ext, BOOLEAN *new)
 	if (OPM_noerr) {
 		OPM_NewSym((void*)OPT_SelfName, 256);
 		if (OPM_noerr) {
-			OPM_SymWInt(16);
-			OPT_OutName((void*)OPT_SelfName, 256);
-			OPT_OutLinks();
+			k = 0;
+			while (k < 9) {
+				OPM_SymWLInt(0);
+				k += 1;
+			}
 			OPT_expCtxt.reffp = 0;
 			OPT_expCtxt.ref = 14;
 			OPT_expCtxt.nofm = 1;
 			OPT_expCtxt.locmno[0] = 0;
+			OPT_expCtxt.mods[0] = 0;
 			i = 1;
 			while (i < 64) {
 				OPT_expCtxt.locmno[__X(i, 64)] = -1;
 				i += 1;
 			}
+			OPT_expCtxt.nofo = 0;
+			OPT_expCtxt.strs = __NEWARR(POINTER__typ, 4, 4, 1, 1, ((ADDRESS)(255)));
+			OPT_expCtxt.objs = __NEWARR(NIL, 4, 4, 1, 1, ((ADDRESS)(256)));
 			OPT_OutObj(OPT_topScope->right);
+			i = 14;
+			while (i < OPT_expCtxt.ref) {
+				OPT_expCtxt.strpos[__X(i, 255)] = OPM_SymWPos();
+				OPT_OutStrDef(OPT_expCtxt.strs->data[__X(i, OPT_expCtxt.strs->len[0])]);
+				i += 1;
+			}
+			modPos = OPM_SymWPos();
+			i = 0;
+			while (i < OPT_expCtxt.nofm) {
+				OPT_OutName((void*)OPT_GlbMod[__X(OPT_expCtxt.mods[__X(i, 64)], 64)]->name->data, OPT_GlbMod[__X(OPT_expCtxt.mods[__X(i, 64)], 64)]->name->len[0]);
+				i += 1;
+			}
+			linkPos = OPM_SymWPos();
+			OPT_OutLinks();
+			strTab = OPM_SymWPos();
+			i = 14;
+			while (i < OPT_expCtxt.ref) {
+				OPM_SymWLInt(OPT_expCtxt.strpos[__X(i, 255)]);
+				i += 1;
+			}
+			objTab = OPM_SymWPos();
+			k = 0;
+			while (k < __ASHL(OPT_expCtxt.nofo, 1)) {
+				OPM_SymWLInt(OPT_expCtxt.objs->data[__X(k, OPT_expCtxt.objs->len[0])]);
+				k += 1;
+			}
+			hashSize = 1;
+			while (hashSize < __ASHL(OPT_expCtxt.nofo, 1)) {
+				hashSize = __ASHL(hashSize, 1);
+			}
+			hash = __NEWARR(NIL, 4, 4, 1, 1, ((ADDRESS)(hashSize)));
+			k = 0;
+			while (k < OPT_expCtxt.nofo) {
+				slot = __MASK(OPT_expCtxt.objs->data[__X(__ASHL(k, 1) + 1, OPT_expCtxt.objs->len[0])], -hashSize);
+				while (hash->data[__X(slot, hash->len[0])] != 0) {
+					slot = __MASK(slot + 1, -hashSize);
+				}
+				hash->data[__X(slot, hash->len[0])] = k + 1;
+				k += 1;
+			}
+			hashTab = OPM_SymWPos();
+			k = 0;
+			while (k < hashSize) {
+				OPM_SymWLInt(hash->data[__X(k, hash->len[0])]);
+				k += 1;
+			}
+			OPM_SymWSetPos(2);
+			OPM_SymWLInt(modPos);
+			OPM_SymWLInt(OPT_expCtxt.nofm);
+			OPM_SymWLInt(linkPos);
+			OPM_SymWLInt(strTab);
+			OPM_SymWLInt(OPT_expCtxt.ref - 14);
+			OPM_SymWLInt(objTab);
+			OPM_SymWLInt(OPT_expCtxt.nofo);
+			OPM_SymWLInt(hashTab);
+			OPM_SymWLInt(hashSize);
+			OPT_expCtxt.strs = NIL;
+			OPT_expCtxt.objs = NIL;
 			*ext = (OPT_sfpresent && OPT_symExtended);
 			*new = (!OPT_sfpresent || OPT_symNew) || __IN(17, OPM_Options, 32);
 			if ((((OPM_noerr && OPT_sfpresent)) && OPT_impCtxt.reffp != OPT_expCtxt.reffp)) {
@@ -2021,66 +2659,45 @@ static void EnumPtrs(void (*P)(void*))
 	__ENUMP(OPT_GlbMod, 64, P);
 	P(OPT_universe);
 	P(OPT_syslink);
-	__ENUMR(&OPT_impCtxt, OPT_ImpCtxt__typ, 3140, 1, P);
+	__ENUMR(&OPT_impCtxt, OPT_ImpCtxt__typ, 1096, 1, P);
+	__ENUMR(&OPT_expCtxt, OPT_ExpCtxt__typ, 1168, 1, P);
+	__ENUMP(OPT_symMods, 64, P);
 	P(OPT_Links);
+	P(OPT_index);
+	__ENUMP(OPT_cacheMod, 64, P);
 }
 
 __TDESC(OPT_ConstDesc, 1, 1) = {__TDFLDS("ConstDesc", 40), {0, -8}};
-__TDESC(OPT_ObjDesc, 1, 6) = {__TDFLDS("ObjDesc", 304), {0, 4, 8, 12, 284, 288, -28}};
+__TDESC(OPT_ObjDesc, 1, 9) = {__TDFLDS("ObjDesc", 64), {0, 4, 8, 12, 16, 32, 36, 56, 60, -40}};
 __TDESC(OPT_StrDesc, 1, 3) = {__TDFLDS("StrDesc", 56), {44, 48, 52, -16}};
 __TDESC(OPT_NodeDesc, 1, 6) = {__TDFLDS("NodeDesc", 28), {0, 4, 8, 16, 20, 24, -28}};
-__TDESC(OPT_ImpCtxt, 1, 510) = {__TDFLDS("ImpCtxt", 3140), {16, 20, 24, 28, 32, 36, 40, 44, 48, 52, 56, 60, 64, 68, 72, 76, 
-	80, 84, 88, 92, 96, 100, 104, 108, 112, 116, 120, 124, 128, 132, 136, 140, 
-	144, 148, 152, 156, 160, 164, 168, 172, 176, 180, 184, 188, 192, 196, 200, 204, 
-	208, 212, 216, 220, 224, 228, 232, 236, 240, 244, 248, 252, 256, 260, 264, 268, 
-	272, 276, 280, 284, 288, 292, 296, 300, 304, 308, 312, 316, 320, 324, 328, 332, 
-	336, 340, 344, 348, 352, 356, 360, 364, 368, 372, 376, 380, 384, 388, 392, 396, 
-	400, 404, 408, 412, 416, 420, 424, 428, 432, 436, 440, 444, 448, 452, 456, 460, 
-	464, 468, 472, 476, 480, 484, 488, 492, 496, 500, 504, 508, 512, 516, 520, 524, 
-	528, 532, 536, 540, 544, 548, 552, 556, 560, 564, 568, 572, 576, 580, 584, 588, 
-	592, 596, 600, 604, 608, 612, 616, 620, 624, 628, 632, 636, 640, 644, 648, 652, 
-	656, 660, 664, 668, 672, 676, 680, 684, 688, 692, 696, 700, 704, 708, 712, 716, 
-	720, 724, 728, 732, 736, 740, 744, 748, 752, 756, 760, 764, 768, 772, 776, 780, 
-	784, 788, 792, 796, 800, 804, 808, 812, 816, 820, 824, 828, 832, 836, 840, 844, 
-	848, 852, 856, 860, 864, 868, 872, 876, 880, 884, 888, 892, 896, 900, 904, 908, 
-	912, 916, 920, 924, 928, 932, 936, 940, 944, 948, 952, 956, 960, 964, 968, 972, 
-	976, 980, 984, 988, 992, 996, 1000, 1004, 1008, 1012, 1016, 1020, 1024, 1028, 1032, 1036, 
-	1040, 1044, 1048, 1052, 1056, 1060, 1064, 1068, 1072, 1076, 1080, 1084, 1088, 1092, 1096, 1100, 
-	1104, 1108, 1112, 1116, 1120, 1124, 1128, 1132, 1136, 1140, 1144, 1148, 1152, 1156, 1160, 1164, 
-	1168, 1172, 1176, 1180, 1184, 1188, 1192, 1196, 1200, 1204, 1208, 1212, 1216, 1220, 1224, 1228, 
-	1232, 1236, 1240, 1244, 1248, 1252, 1256, 1260, 1264, 1268, 1272, 1276, 1280, 1284, 1288, 1292, 
-	1296, 1300, 1304, 1308, 1312, 1316, 1320, 1324, 1328, 1332, 1336, 1340, 1344, 1348, 1352, 1356, 
-	1360, 1364, 1368, 1372, 1376, 1380, 1384, 1388, 1392, 1396, 1400, 1404, 1408, 1412, 1416, 1420, 
-	1424, 1428, 1432, 1436, 1440, 1444, 1448, 1452, 1456, 1460, 1464, 1468, 1472, 1476, 1480, 1484, 
-	1488, 1492, 1496, 1500, 1504, 1508, 1512, 1516, 1520, 1524, 1528, 1532, 1536, 1540, 1544, 1548, 
-	1552, 1556, 1560, 1564, 1568, 1572, 1576, 1580, 1584, 1588, 1592, 1596, 1600, 1604, 1608, 1612, 
-	1616, 1620, 1624, 1628, 1632, 1636, 1640, 1644, 1648, 1652, 1656, 1660, 1664, 1668, 1672, 1676, 
-	1680, 1684, 1688, 1692, 1696, 1700, 1704, 1708, 1712, 1716, 1720, 1724, 1728, 1732, 1736, 1740, 
-	1744, 1748, 1752, 1756, 1760, 1764, 1768, 1772, 1776, 1780, 1784, 1788, 1792, 1796, 1800, 1804, 
-	1808, 1812, 1816, 1820, 1824, 1828, 1832, 1836, 1840, 1844, 1848, 1852, 1856, 1860, 1864, 1868, 
-	1872, 1876, 1880, 1884, 1888, 1892, 1896, 1900, 1904, 1908, 1912, 1916, 1920, 1924, 1928, 1932, 
-	1936, 1940, 1944, 1948, 1952, 1956, 1960, 1964, 1968, 1972, 1976, 1980, 1984, 1988, 1992, 1996, 
-	2000, 2004, 2008, 2012, 2016, 2020, 2024, 2028, 2032, 2036, 2040, 2044, 2048, 2052, -2044}};
-__TDESC(OPT_ExpCtxt, 1, 0) = {__TDFLDS("ExpCtxt", 72), {-4}};
+__TDESC(OPT_ImpCtxt, 1, 15) = {__TDFLDS("ImpCtxt", 1096), {16, 20, 24, 28, 32, 36, 40, 44, 48, 52, 56, 60, 64, 68, 72, -64}};
+__TDESC(OPT_ExpCtxt, 1, 2) = {__TDFLDS("ExpCtxt", 1168), {1160, 1164, -12}};
+__TDESC(OPT_SymModDesc, 1, 5) = {__TDFLDS("SymModDesc", 108), {0, 92, 96, 100, 104, -24}};
 __TDESC(OPT_LinkDesc, 1, 1) = {__TDFLDS("LinkDesc", 260), {256, -8}};
 
 export void *OPT__init(void)
 {
 	__DEFMOD;
+	__MODULE_IMPORT(Heap);
 	__MODULE_IMPORT(OPM);
 	__MODULE_IMPORT(OPS);
+	__MODULE_IMPORT(Platform);
 	__REGMOD("OPT", EnumPtrs);
 	__REGCMD("Close", OPT_Close);
 	__REGCMD("CloseScope", OPT_CloseScope);
 	__REGCMD("InitRecno", OPT_InitRecno);
+	__REGCMD("UseCache", OPT_UseCache);
 	__INITYP(OPT_ConstDesc, OPT_ConstDesc, 0);
 	__INITYP(OPT_ObjDesc, OPT_ObjDesc, 0);
 	__INITYP(OPT_StrDesc, OPT_StrDesc, 0);
 	__INITYP(OPT_NodeDesc, OPT_NodeDesc, 0);
 	__INITYP(OPT_ImpCtxt, OPT_ImpCtxt, 0);
 	__INITYP(OPT_ExpCtxt, OPT_ExpCtxt, 0);
+	__INITYP(OPT_SymModDesc, OPT_SymModDesc, 0);
 	__INITYP(OPT_LinkDesc, OPT_LinkDesc, 0);
 /* BEGIN */
+	OPT_ResetIndex();
 	OPT_topScope = NIL;
 	OPT_OpenScope(0, NIL);
 	OPM_errpos = 0;
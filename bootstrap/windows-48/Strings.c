@@ -241,9 +241,11 @@ BOOLEAN Strings_Match (CHAR *string, ADDRESS string__len, CHAR *pattern, ADDRESS
 
 void Strings_StrToReal (CHAR *s, ADDRESS s__len, REAL *r)
 {
-	INT16 p, e;
-	REAL y, g;
-	BOOLEAN neg, negE;
+	INT16 p, n, e;
+	INT32 x;
+	CHAR d[65];
+	REAL y;
+	BOOLEAN neg, negE, sticky;
 	__DUP(s, s__len, CHAR);
 	p = 0;
 	while (s[__X(p, s__len)] == ' ' || s[__X(p, s__len)] == '0') {
@@ -258,20 +260,41 @@ void Strings_StrToReal (CHAR *s, ADDRESS s__len, REAL *r)
 	while (s[__X(p, s__len)] == ' ' || s[__X(p, s__len)] == '0') {
 		p += 1;
 	}
-	y = (REAL)0;
+	n = 0;
+	x = 0;
+	sticky = 0;
 	while (('0' <= s[__X(p, s__len)] && s[__X(p, s__len)] <= '9')) {
-		y = y * (REAL)10 + ((INT16)s[__X(p, s__len)] - 48);
+		if (n < 64) {
+			d[__X(n, 65)] = s[__X(p, s__len)];
+			n += 1;
+		} else {
+			if (s[__X(p, s__len)] != '0') {
+				sticky = 1;
+			}
+			x += 1;
+		}
 		p += 1;
 	}
 	if (s[__X(p, s__len)] == '.') {
 		p += 1;
-		g = (REAL)1;
 		while (('0' <= s[__X(p, s__len)] && s[__X(p, s__len)] <= '9')) {
-			g = g / (REAL)(REAL)10;
-			y = y + g * ((INT16)s[__X(p, s__len)] - 48);
+			if ((n == 0 && s[__X(p, s__len)] == '0')) {
+				x -= 1;
+			} else if (n < 64) {
+				d[__X(n, 65)] = s[__X(p, s__len)];
+				n += 1;
+				x -= 1;
+			} else if (s[__X(p, s__len)] != '0') {
+				sticky = 1;
+			}
 			p += 1;
 		}
 	}
+	if (sticky) {
+		d[64] = '1';
+		n = 65;
+		x -= 1;
+	}
 	if (s[__X(p, s__len)] == 'D' || s[__X(p, s__len)] == 'E') {
 		p += 1;
 		e = 0;
@@ -289,11 +312,12 @@ void Strings_StrToReal (CHAR *s, ADDRESS s__len, REAL *r)
 			p += 1;
 		}
 		if (negE) {
-			y = y / (REAL)Reals_Ten(e);
+			x -= e;
 		} else {
-			y = y * Reals_Ten(e);
+			x += e;
 		}
 	}
+	y = Reals_Decimal((void*)d, 65, n, x);
 	if (neg) {
 		y = -y;
 	}
@@ -303,9 +327,11 @@ void Strings_StrToReal (CHAR *s, ADDRESS s__len, REAL *r)
 
 void Strings_StrToLongReal (CHAR *s, ADDRESS s__len, LONGREAL *r)
 {
-	INT16 p, e;
-	LONGREAL y, g;
-	BOOLEAN neg, negE;
+	INT16 p, n, e;
+	INT32 x;
+	CHAR d[65];
+	LONGREAL y;
+	BOOLEAN neg, negE, sticky;
 	__DUP(s, s__len, CHAR);
 	p = 0;
 	while (s[__X(p, s__len)] == ' ' || s[__X(p, s__len)] == '0') {
@@ -320,20 +346,41 @@ void Strings_StrToLongReal (CHAR *s, ADDRESS s__len, LONGREAL *r)
 	while (s[__X(p, s__len)] == ' ' || s[__X(p, s__len)] == '0') {
 		p += 1;
 	}
-	y = (LONGREAL)0;
+	n = 0;
+	x = 0;
+	sticky = 0;
 	while (('0' <= s[__X(p, s__len)] && s[__X(p, s__len)] <= '9')) {
-		y = y * (LONGREAL)10 + ((INT16)s[__X(p, s__len)] - 48);
+		if (n < 64) {
+			d[__X(n, 65)] = s[__X(p, s__len)];
+			n += 1;
+		} else {
+			if (s[__X(p, s__len)] != '0') {
+				sticky = 1;
+			}
+			x += 1;
+		}
 		p += 1;
 	}
 	if (s[__X(p, s__len)] == '.') {
 		p += 1;
-		g = (LONGREAL)1;
 		while (('0' <= s[__X(p, s__len)] && s[__X(p, s__len)] <= '9')) {
-			g = g / (LONGREAL)(LONGREAL)10;
-			y = y + g * ((INT16)s[__X(p, s__len)] - 48);
+			if ((n == 0 && s[__X(p, s__len)] == '0')) {
+				x -= 1;
+			} else if (n < 64) {
+				d[__X(n, 65)] = s[__X(p, s__len)];
+				n += 1;
+				x -= 1;
+			} else if (s[__X(p, s__len)] != '0') {
+				sticky = 1;
+			}
 			p += 1;
 		}
 	}
+	if (sticky) {
+		d[64] = '1';
+		n = 65;
+		x -= 1;
+	}
 	if (s[__X(p, s__len)] == 'D' || s[__X(p, s__len)] == 'E') {
 		p += 1;
 		e = 0;
@@ -351,11 +398,12 @@ void Strings_StrToLongReal (CHAR *s, ADDRESS s__len, LONGREAL *r)
 			p += 1;
 		}
 		if (negE) {
-			y = y / (LONGREAL)Reals_Ten(e);
+			x -= e;
 		} else {
-			y = y * Reals_Ten(e);
+			x += e;
 		}
 	}
+	y = Reals_DecimalL((void*)d, 65, n, x);
 	if (neg) {
 		y = -y;
 	}
@@ -7,43 +7,554 @@
 
 #include "SYSTEM.h"
 #include "Configuration.h"
+#include "Files.h"
 #include "Heap.h"
+#include "Modules.h"
 #include "OPB.h"
 #include "OPC.h"
 #include "OPM.h"
 #include "OPP.h"
+#include "OPS.h"
 #include "OPT.h"
 #include "OPV.h"
+#include "Out.h"
 #include "Platform.h"
 #include "Strings.h"
 #include "VT100.h"
 #include "extTools.h"
 
 
+static INT32 Compiler_srcfp;
+static OPT_Link Compiler_unity, Compiler_assembled;
+static Files_File Compiler_statsFile, Compiler_buildState;
+static Files_Rider Compiler_stats;
+static INT32 Compiler_nofStats, Compiler_wall0, Compiler_cpu0, Compiler_lines;
+static INT32 Compiler_phaseTotal[4];
+static BOOLEAN Compiler_serving;
+static CHAR Compiler_socket[256];
+static INT64 Compiler_report;
+static struct {
+	ADDRESS len[1];
+	CHAR data[1];
+} *Compiler_request;
+static struct {
+	ADDRESS len[1];
+	ADDRESS data[1];
+} *Compiler_argv;
 
 
+static void Compiler_Append (CHAR *s, ADDRESS s__len, INT32 *n);
+static void Compiler_Client (void);
+static BOOLEAN Compiler_FileFPrint (CHAR *name, ADDRESS name__len, INT32 *fp);
 static void Compiler_FindLocalObjectFiles (CHAR *objectnames, ADDRESS objectnames__len);
+static void Compiler_Handle (INT64 h, INT64 c);
+static BOOLEAN Compiler_InUnity (CHAR *name, ADDRESS name__len);
 export void Compiler_Module (BOOLEAN *done);
+static INT32 Compiler_OptionsFPrint (void);
+static void Compiler_OpenStats (void);
+static BOOLEAN Compiler_OutputPresent (CHAR *name, ADDRESS name__len, CHAR *ext, ADDRESS ext__len);
+static INT64 Compiler_PausePercentile (INT16 p);
+static void Compiler_ProfileRebuild (CHAR *linkfiles, ADDRESS linkfiles__len);
 static void Compiler_PropagateElementaryTypeSizes (void);
+static BOOLEAN Compiler_ReadRequest (INT64 c);
+static void Compiler_RecordStats (void);
+static void Compiler_Remember (OPT_Link *list);
+static void Compiler_Report (void);
+static void Compiler_Serve (void);
+static void Compiler_StateFileName (CHAR *name, ADDRESS name__len);
 export void Compiler_Translate (void);
 static void Compiler_Trap (INT32 sig);
+static BOOLEAN Compiler_UpToDate (void);
+static void Compiler_Warm (CHAR *names, ADDRESS names__len);
+static void Compiler_WriteBuildState (void);
+static void Compiler_WriteNum (INT64 n);
+static void Compiler_WritePhases (INT32 *t, ADDRESS t__len);
+static void Compiler_WriteStats (void);
+static void Compiler_WriteText (Files_Rider *r, ADDRESS *r__typ, CHAR *s, ADDRESS s__len);
+static void Compiler_WriteUnityFile (void);
 
 
+static BOOLEAN Compiler_FileFPrint (CHAR *name, ADDRESS name__len, INT32 *fp)
+{
+	Files_File f = NIL;
+	Files_Rider r;
+	CHAR buf[4096];
+	INT32 i, n;
+	__DUP(name, name__len, CHAR);
+	*fp = 0;
+	f = Files_Old(name, name__len);
+	if (f == NIL) {
+		__DEL(name);
+		return 0;
+	}
+	Files_Set(&r, Files_Rider__typ, f, 0);
+	do {
+		Files_ReadBytes(&r, Files_Rider__typ, (void*)buf, 4096, 4096);
+		n = 4096 - r.res;
+		i = 0;
+		while (i < n) {
+			*fp = (INT32)(((UINT32)*fp ^ (UINT32)buf[__X(i, 4096)]) * 16777619);
+			i += 1;
+		}
+	} while (!(n < 4096));
+	Files_Close(f);
+	__DEL(name);
+	return 1;
+}
+
+static INT32 Compiler_OptionsFPrint (void)
+{
+	INT32 fp;
+	INT16 i;
+	CHAR cflags[1024];
+	fp = 0;
+	OPM_FPrintSet(&fp, OPM_Options & ~0x2f0210);
+	OPM_FPrint(&fp, OPM_Model[0]);
+	OPM_FPrint(&fp, OPM_AddressSize);
+	OPM_FPrint(&fp, OPM_Alignment);
+	OPM_FPrint(&fp, OPM_Profile);
+	i = 0;
+	while (Configuration_versionLong[__X(i, 76)] != 0x00) {
+		OPM_FPrint(&fp, Configuration_versionLong[__X(i, 76)]);
+		i += 1;
+	}
+	Platform_GetEnv((CHAR*)"CFLAGS", 7, (void*)cflags, 1024);
+	i = 0;
+	while (cflags[__X(i, 1024)] != 0x00) {
+		OPM_FPrint(&fp, cflags[__X(i, 1024)]);
+		i += 1;
+	}
+	return fp;
+}
+
+static void Compiler_StateFileName (CHAR *name, ADDRESS name__len)
+{
+	INT16 i, j, dot;
+	CHAR ch;
+	i = 0;
+	j = 0;
+	dot = -1;
+	ch = OPM_SourceFileName[0];
+	while (ch != 0x00) {
+		if ((ch == '/' || ch == '\\')) {
+			j = 0;
+			dot = -1;
+		} else {
+			if (ch == '.') {
+				dot = j;
+			}
+			name[__X(j, name__len)] = ch;
+			j += 1;
+		}
+		i += 1;
+		ch = OPM_SourceFileName[__X(i, 256)];
+	}
+	if (dot > 0) {
+		j = dot;
+	}
+	name[__X(j, name__len)] = 0x00;
+	Strings_Append((CHAR*)".bld", 5, (void*)name, name__len);
+}
+
+static BOOLEAN Compiler_OutputPresent (CHAR *name, ADDRESS name__len, CHAR *ext, ADDRESS ext__len)
+{
+	CHAR fn[64];
+	Platform_FileIdentity id;
+	__DUP(name, name__len, CHAR);
+	__DUP(ext, ext__len, CHAR);
+	__COPY(name, fn, 64);
+	Strings_Append(ext, ext__len, (void*)fn, 64);
+	__DEL(name);
+	__DEL(ext);
+	return Platform_IdentifyByName(fn, 64, &id, Platform_FileIdentity__typ) == 0;
+}
+
+static BOOLEAN Compiler_UpToDate (void)
+{
+	Files_File f = NIL;
+	Files_Rider r;
+	CHAR tag, version;
+	CHAR fn[256], name[256];
+	INT32 fp, cur;
+	BOOLEAN ok;
+	ok = Compiler_FileFPrint(OPM_SourceFileName, 256, &Compiler_srcfp);
+	if ((!ok || __IN(10, OPM_Options, 32))) {
+		return 0;
+	}
+	Compiler_StateFileName((void*)fn, 256);
+	f = Files_Old(fn, 256);
+	if (f == NIL) {
+		return 0;
+	}
+	Files_Set(&r, Files_Rider__typ, f, 0);
+	Files_Read(&r, Files_Rider__typ, (void*)&tag);
+	Files_Read(&r, Files_Rider__typ, (void*)&version);
+	ok = (tag == 0xf5 && version == 0x01);
+	if (ok) {
+		Files_ReadString(&r, Files_Rider__typ, (void*)name, 256);
+		ok = __STRCMP(name, OPM_SourceFileName) == 0;
+	}
+	if (ok) {
+		Files_ReadNum(&r, Files_Rider__typ, (void*)&fp, 4);
+		ok = fp == Compiler_srcfp;
+	}
+	if (ok) {
+		Files_ReadNum(&r, Files_Rider__typ, (void*)&fp, 4);
+		ok = fp == Compiler_OptionsFPrint();
+	}
+	if (ok) {
+		Files_ReadString(&r, Files_Rider__typ, (void*)OPM_modName, 32);
+		ok = (((Compiler_OutputPresent((void*)OPM_modName, 32, (CHAR*)".c", 3) && Compiler_OutputPresent((void*)OPM_modName, 32, (CHAR*)".h", 3))) && Compiler_OutputPresent((void*)OPM_modName, 32, (CHAR*)".sym", 5));
+		if ((((ok && !__IN(13, OPM_Options, 32))) && (!__IN(20, OPM_Options, 32) || __IN(14, OPM_Options, 32)))) {
+			ok = Compiler_OutputPresent((void*)OPM_modName, 32, (CHAR*)".o", 3);
+		}
+	}
+	if (ok) {
+		Files_ReadString(&r, Files_Rider__typ, (void*)name, 256);
+		while ((ok && name[0] != 0x00)) {
+			Files_ReadNum(&r, Files_Rider__typ, (void*)&fp, 4);
+			Strings_Append((CHAR*)".sym", 5, (void*)name, 256);
+			ok = (Compiler_FileFPrint(name, 256, &cur) && cur == fp);
+			Files_ReadString(&r, Files_Rider__typ, (void*)name, 256);
+		}
+		ok = (ok && !r.eof);
+	}
+	Files_Close(f);
+	return ok;
+}
+
+static void Compiler_WriteBuildState (void)
+{
+	Files_File f = NIL;
+	Files_Rider r;
+	CHAR fn[256], name[256];
+	INT32 fp;
+	INT16 i;
+	Compiler_StateFileName((void*)fn, 256);
+	f = Files_New(fn, 256);
+	if (f != NIL) {
+		Files_Set(&r, Files_Rider__typ, f, 0);
+		Files_Write(&r, Files_Rider__typ, 0xf5);
+		Files_Write(&r, Files_Rider__typ, 0x01);
+		Files_WriteString(&r, Files_Rider__typ, OPM_SourceFileName, 256);
+		Files_WriteNum(&r, Files_Rider__typ, Compiler_srcfp);
+		Files_WriteNum(&r, Files_Rider__typ, Compiler_OptionsFPrint());
+		Files_WriteString(&r, Files_Rider__typ, OPM_modName, 32);
+		i = 1;
+		while (i < OPT_nofGmod) {
+			__COPY(OPT_GlbMod[__X(i, 64)]->name->data, name, 256);
+			Files_WriteString(&r, Files_Rider__typ, name, 256);
+			Strings_Append((CHAR*)".sym", 5, (void*)name, 256);
+			if (!Compiler_FileFPrint(name, 256, &fp)) {
+				fp = 0;
+			}
+			Files_WriteNum(&r, Files_Rider__typ, fp);
+			i += 1;
+		}
+		Files_WriteString(&r, Files_Rider__typ, (CHAR*)"", 1);
+		Compiler_buildState = f;
+	}
+}
+
+static void Compiler_Remember (OPT_Link *list)
+{
+	OPT_Link l = NIL, n = NIL;
+	__NEW(n, OPT_LinkDesc);
+	__COPY(OPM_modName, n->name, 256);
+	if (*list == NIL) {
+		*list = n;
+	} else {
+		l = *list;
+		while (l->next != NIL) {
+			l = l->next;
+		}
+		l->next = n;
+	}
+}
+
+static BOOLEAN Compiler_InUnity (CHAR *name, ADDRESS name__len)
+{
+	OPT_Link l = NIL;
+	l = Compiler_unity;
+	while ((l != NIL && __STRCMP(l->name, name) != 0)) {
+		l = l->next;
+	}
+	return l != NIL;
+}
+
+static void Compiler_WriteText (Files_Rider *r, ADDRESS *r__typ, CHAR *s, ADDRESS s__len)
+{
+	INT16 i;
+	i = 0;
+	while (s[__X(i, s__len)] != 0x00) {
+		Files_Write(&*r, r__typ, s[__X(i, s__len)]);
+		i += 1;
+	}
+}
+
+static void Compiler_WriteUnityFile (void)
+{
+	Files_File f = NIL;
+	Files_Rider r;
+	CHAR fn[64];
+	OPT_Link l = NIL;
+	__COPY(OPM_modName, fn, 64);
+	Strings_Append((CHAR*)".unity.c", 9, (void*)fn, 64);
+	f = Files_New(fn, 64);
+	if (f != NIL) {
+		Files_Set(&r, Files_Rider__typ, f, 0);
+		Compiler_WriteText(&r, Files_Rider__typ, (CHAR*)"/* Unity build of ", 19);
+		Compiler_WriteText(&r, Files_Rider__typ, OPM_modName, 32);
+		Compiler_WriteText(&r, Files_Rider__typ, (CHAR*)". */\n", 6);
+		l = Compiler_unity;
+		while (l != NIL) {
+			Compiler_WriteText(&r, Files_Rider__typ, (CHAR*)"\n#define EnumPtrs ", 19);
+			Compiler_WriteText(&r, Files_Rider__typ, l->name, 256);
+			Compiler_WriteText(&r, Files_Rider__typ, (CHAR*)"__EnumPtrs\n#include \"", 22);
+			Compiler_WriteText(&r, Files_Rider__typ, l->name, 256);
+			Compiler_WriteText(&r, Files_Rider__typ, (CHAR*)".c\"\n#undef EnumPtrs\n#define ", 29);
+			Compiler_WriteText(&r, Files_Rider__typ, l->name, 256);
+			Compiler_WriteText(&r, Files_Rider__typ, (CHAR*)"__h\n", 5);
+			l = l->next;
+		}
+		Compiler_WriteText(&r, Files_Rider__typ, (CHAR*)"\n#include \"", 12);
+		Compiler_WriteText(&r, Files_Rider__typ, OPM_modName, 32);
+		Compiler_WriteText(&r, Files_Rider__typ, (CHAR*)".c\"\n", 5);
+		Files_Register(f);
+	}
+}
+
+static void Compiler_WriteNum (INT64 n)
+{
+	CHAR s[24];
+	INT16 i;
+	if (n < 0) {
+		Files_Write(&Compiler_stats, Files_Rider__typ, '-');
+		n = -n;
+	}
+	i = 0;
+	do {
+		s[__X(i, 24)] = __CHR((int)__MOD(n, 10) + 48);
+		n = __DIV(n, 10);
+		i += 1;
+	} while (!(n == 0));
+	do {
+		i -= 1;
+		Files_Write(&Compiler_stats, Files_Rider__typ, s[__X(i, 24)]);
+	} while (!(i == 0));
+}
+
+static void Compiler_WritePhases (INT32 *t, ADDRESS t__len)
+{
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)"{\"parse\": ", 11);
+	Compiler_WriteNum(t[0]);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)", \"import\": ", 13);
+	Compiler_WriteNum(t[__X(1, t__len)]);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)", \"export\": ", 13);
+	Compiler_WriteNum(t[__X(2, t__len)]);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)", \"codegen\": ", 14);
+	Compiler_WriteNum(t[__X(3, t__len)]);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)"}", 2);
+}
+
+static void Compiler_OpenStats (void)
+{
+	Compiler_statsFile = Files_New((CHAR*)"build-stats.json", 17);
+	if (Compiler_statsFile != NIL) {
+		Files_Set(&Compiler_stats, Files_Rider__typ, Compiler_statsFile, 0);
+		Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)"{\"modules\": [", 14);
+		Compiler_nofStats = 0;
+		Compiler_lines = 0;
+		Compiler_phaseTotal[0] = 0;
+		Compiler_phaseTotal[1] = 0;
+		Compiler_phaseTotal[2] = 0;
+		Compiler_phaseTotal[3] = 0;
+		Compiler_wall0 = Platform_Time();
+		Compiler_cpu0 = Platform_CpuTime();
+	}
+}
+
+static void Compiler_RecordStats (void)
+{
+	INT32 w[4], c[4];
+	INT16 i;
+	i = 0;
+	while (i < 4) {
+		w[__X(i, 4)] = OPM_phaseWall[__X(i, 5)];
+		c[__X(i, 4)] = OPM_phaseCpu[__X(i, 5)];
+		i += 1;
+	}
+	w[0] -= w[1];
+	c[0] -= c[1];
+	i = 0;
+	while (i < 4) {
+		Compiler_phaseTotal[__X(i, 4)] += w[__X(i, 4)];
+		i += 1;
+	}
+	Compiler_lines += OPM_nofLines;
+	if (Compiler_nofStats > 0) {
+		Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)",", 2);
+	}
+	Compiler_nofStats += 1;
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)"\n  {\"name\": \"", 14);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, OPM_modName, 32);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)"\", \"lines\": ", 13);
+	Compiler_WriteNum(OPM_nofLines);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)", \"wall_ms\": ", 14);
+	Compiler_WritePhases((void*)w, 4);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)", \"cpu_ms\": ", 13);
+	Compiler_WritePhases((void*)c, 4);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)", \"tokens\": ", 13);
+	Compiler_WriteNum(OPS_nofTokens);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)", \"nodes\": ", 12);
+	Compiler_WriteNum(OPT_nofNodes);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)", \"imported\": ", 15);
+	Compiler_WriteNum(OPT_nofImported);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)", \"bytes\": ", 12);
+	Compiler_WriteNum(OPM_nofBytes);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)", \"checks\": {\"index\": ", 23);
+	Compiler_WriteNum(OPV_nofIndexChecks);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)", \"range\": ", 12);
+	Compiler_WriteNum(OPV_nofRangeChecks);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)", \"guard\": ", 12);
+	Compiler_WriteNum(OPV_nofGuards);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)", \"divmod\": ", 13);
+	Compiler_WriteNum(OPV_nofDivMods);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)"}}", 3);
+}
+
+static INT64 Compiler_PausePercentile (INT16 p)
+{
+	INT64 n, k;
+	INT16 i;
+	n = 0;
+	i = 0;
+	while (i < 24) {
+		n += Heap_pauses[__X(i, 24)];
+		i += 1;
+	}
+	k = __DIV(n * p + 99, 100);
+	if (k == 0) {
+		return 0;
+	}
+	i = 0;
+	n = Heap_pauses[0];
+	while (n < k) {
+		i += 1;
+		n += Heap_pauses[__X(i, 24)];
+	}
+	if ((i < 23 && __ASHL(1, i) < Heap_pauseMax)) {
+		return __ASHL(1, i);
+	}
+	return Heap_pauseMax;
+}
+
+static void Compiler_WriteStats (void)
+{
+	INT64 high;
+	INT32 rate[4], wall;
+	INT16 i;
+	wall = Platform_Time() - Compiler_wall0;
+	i = 0;
+	while (i < 4) {
+		if (Compiler_phaseTotal[__X(i, 4)] > 0) {
+			rate[__X(i, 4)] = (INT32)__DIV((INT64)Compiler_lines * 1000, Compiler_phaseTotal[__X(i, 4)]);
+		} else {
+			rate[__X(i, 4)] = 0;
+		}
+		i += 1;
+	}
+	high = Heap_allocated;
+	if (Heap_highWater > high) {
+		high = Heap_highWater;
+	}
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)"\n],\n\"lines\": ", 14);
+	Compiler_WriteNum(Compiler_lines);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)",\n\"phase_wall_ms\": ", 20);
+	Compiler_WritePhases((void*)Compiler_phaseTotal, 4);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)",\n\"lines_per_s\": ", 18);
+	Compiler_WritePhases((void*)rate, 4);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)",\n\"cc_wall_ms\": ", 17);
+	Compiler_WriteNum(OPM_phaseWall[4]);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)",\n\"total_wall_ms\": ", 20);
+	Compiler_WriteNum(wall);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)",\n\"total_cpu_ms\": ", 19);
+	Compiler_WriteNum(Platform_CpuTime() - Compiler_cpu0);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)",\n\"gc_collections\": ", 21);
+	Compiler_WriteNum(Heap_collections);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)",\n\"heap_high_water\": ", 22);
+	Compiler_WriteNum(high);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)",\n\"allocated_bytes\": ", 22);
+	Compiler_WriteNum(Heap_allocatedTotal);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)",\n\"alloc_bytes_per_s\": ", 24);
+	if (wall > 0) {
+		Compiler_WriteNum(__DIV(Heap_allocatedTotal * 1000, wall));
+	} else {
+		Compiler_WriteNum(0);
+	}
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)",\n\"gc_pause_total_us\": ", 24);
+	Compiler_WriteNum(Heap_pauseTotal);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)",\n\"gc_pause_max_us\": ", 22);
+	Compiler_WriteNum(Heap_pauseMax);
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)",\n\"gc_pause_p50_us\": ", 22);
+	Compiler_WriteNum(Compiler_PausePercentile(50));
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)",\n\"gc_pause_p99_us\": ", 22);
+	Compiler_WriteNum(Compiler_PausePercentile(99));
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)",\n\"peak_rss_kb\": ", 18);
+	Compiler_WriteNum(Platform_MaxRSS());
+	Compiler_WriteText(&Compiler_stats, Files_Rider__typ, (CHAR*)"\n}\n", 4);
+	Files_Register(Compiler_statsFile);
+	Compiler_statsFile = NIL;
+	OPM_LogWStr((CHAR*)"Statistics written to build-stats.json.", 40);
+	OPM_LogWLn();
+}
+
+static void Compiler_Report (void)
+{
+	INT16 i, res;
+	OPS_Ident name = NIL;
+	i = 1;
+	while (i < OPT_nofGmod) {
+		name = OPT_GlbMod[__X(i, 64)]->name;
+		res = Platform_Write(Compiler_report, (ADDRESS)&name->data[0], Strings_Length(name->data, name->len[0]) + 1);
+		i += 1;
+	}
+}
+
 void Compiler_Module (BOOLEAN *done)
 {
 	BOOLEAN ext, new;
 	OPT_Node p = NIL;
+	INT16 i;
+	i = 0;
+	while (i < 4) {
+		OPM_phaseWall[__X(i, 5)] = 0;
+		OPM_phaseCpu[__X(i, 5)] = 0;
+		i += 1;
+	}
+	OPS_nofTokens = 0;
+	OPT_nofNodes = 0;
+	OPT_nofImported = 0;
+	OPM_StartPhase(0);
 	OPP_Module(&p, OPM_Options);
+	OPM_StopPhase(0);
 	if (OPM_noerr) {
 		OPV_Init();
 		OPT_InitRecno();
 		OPV_AdrAndSize(OPT_topScope);
+		OPM_StartPhase(2);
 		OPT_Export(&ext, &new);
+		OPM_StopPhase(2);
 		if (OPM_noerr) {
 			OPM_OpenFiles((void*)OPT_SelfName, 256);
 			OPM_DeleteObj((void*)OPT_SelfName, 256);
 			OPC_Init();
+			OPM_StartPhase(3);
+			if (__IN(22, OPM_Options, 32)) {
+				OPB_Optimize(p);
+			}
 			OPV_Module(p);
+			OPM_StopPhase(3);
 			if (OPM_noerr) {
 				if ((__IN(10, OPM_Options, 32) && __STRCMP(OPM_modName, "SYSTEM") != 0)) {
 					OPM_DeleteSym((void*)OPT_SelfName, 256);
@@ -61,13 +572,22 @@ void Compiler_Module (BOOLEAN *done)
 						OPM_RegisterNewSym();
 					}
 				}
+				if (__IN(19, OPM_Options, 32)) {
+					Compiler_WriteBuildState();
+				}
 			} else {
 				OPM_DeleteSym((void*)OPT_SelfName, 256);
 			}
 		}
 	}
 	OPM_CloseFiles();
+	if (Compiler_report >= 0) {
+		Compiler_Report();
+	}
 	OPT_Close();
+	if (Compiler_statsFile != NIL) {
+		Compiler_RecordStats();
+	}
 	OPM_LogWLn();
 	*done = OPM_noerr;
 }
@@ -99,9 +619,9 @@ static void Compiler_PropagateElementaryTypeSizes (void)
 	}
 	OPT_setobj->typ = OPT_settyp;
 	if (__STRCMP(OPM_Model, "C") == 0) {
-		OPT_cpbytetyp->strobj->name[4] = 0x00;
+		OPT_cpbytetyp->strobj->name = OPS_Intern((CHAR*)"BYTE", 5);
 	} else {
-		OPT_cpbytetyp->strobj->name[4] = '@';
+		OPT_cpbytetyp->strobj->name = OPS_Intern((CHAR*)"BYTE@", 6);
 	}
 }
 
@@ -115,7 +635,7 @@ static void Compiler_FindLocalObjectFiles (CHAR *objectnames, ADDRESS objectname
 	while (l != NIL) {
 		__COPY(l->name, fn, 64);
 		Strings_Append((CHAR*)".sym", 5, (void*)fn, 64);
-		if (Platform_IdentifyByName(fn, 64, &id, Platform_FileIdentity__typ) == 0) {
+		if ((!Compiler_InUnity(l->name, 256) && Platform_IdentifyByName(fn, 64, &id, Platform_FileIdentity__typ) == 0)) {
 			__COPY(l->name, fn, 64);
 			Strings_Append((CHAR*)".o", 3, (void*)fn, 64);
 			if (Platform_IdentifyByName(fn, 64, &id, Platform_FileIdentity__typ) == 0) {
@@ -136,44 +656,380 @@ static void Compiler_FindLocalObjectFiles (CHAR *objectnames, ADDRESS objectname
 	}
 }
 
+static void Compiler_ProfileRebuild (CHAR *linkfiles, ADDRESS linkfiles__len)
+{
+	OPT_Link l = NIL;
+	extTools_Train(OPM_modName, 32);
+	extTools_useProfile = 1;
+	l = Compiler_assembled;
+	while (l != NIL) {
+		extTools_Assemble(l->name, 256, NIL);
+		l = l->next;
+	}
+	extTools_LinkMain((void*)OPM_modName, 32, __IN(15, OPM_Options, 32), linkfiles, linkfiles__len);
+	extTools_useProfile = 0;
+}
+
 void Compiler_Translate (void)
 {
 	BOOLEAN done;
 	CHAR linkfiles[2048];
+	CHAR statefile[256];
+	INT16 res;
 	if (OPM_OpenPar()) {
+		if (__IN(21, OPM_GlobalOptions, 32)) {
+			Compiler_OpenStats();
+		}
 		for (;;) {
 			OPM_Init(&done);
 			if (!done) {
+				extTools_WaitAll();
+				if (Compiler_statsFile != NIL) {
+					Compiler_WriteStats();
+				}
 				return;
 			}
 			OPM_InitOptions();
-			Compiler_PropagateElementaryTypeSizes();
-			Heap_GC(0);
-			Compiler_Module(&done);
-			if (!done) {
-				OPM_LogWLn();
-				OPM_LogWStr((CHAR*)"Module compilation failed.", 27);
+			if ((__IN(19, OPM_Options, 32) && Compiler_UpToDate())) {
+				OPM_LogWStr((CHAR*)"Unchanged ", 11);
+				OPM_LogWStr(OPM_modName, 32);
+				OPM_LogW('.');
 				OPM_LogWLn();
-				Platform_Exit(1);
-			}
-			if (!__IN(13, OPM_Options, 32)) {
-				if (__IN(14, OPM_Options, 32)) {
-					extTools_Assemble(OPM_modName, 32);
-				} else {
-					if (!__IN(10, OPM_Options, 32)) {
-						extTools_Assemble(OPM_modName, 32);
+				if (!__IN(13, OPM_Options, 32)) {
+					if ((__IN(20, OPM_Options, 32) && !__IN(14, OPM_Options, 32))) {
+						Compiler_Remember(&Compiler_unity);
 					} else {
-						Compiler_FindLocalObjectFiles((void*)linkfiles, 2048);
-						extTools_LinkMain((void*)OPM_modName, 32, __IN(15, OPM_Options, 32), linkfiles, 2048);
+						Compiler_Remember(&Compiler_assembled);
 					}
 				}
+			} else {
+				if (!__IN(19, OPM_Options, 32)) {
+					Compiler_StateFileName((void*)statefile, 256);
+					Files_Delete(statefile, 256, &res);
+				}
+				Compiler_PropagateElementaryTypeSizes();
+				Heap_GC(0);
+				Compiler_Module(&done);
+				if (!done) {
+					OPM_LogWLn();
+					OPM_LogWStr((CHAR*)"Module compilation failed.", 27);
+					OPM_LogWLn();
+					extTools_WaitAll();
+					Heap_FINALL();
+					Platform_Exit(1);
+				}
+				if (!__IN(13, OPM_Options, 32)) {
+					if (__IN(14, OPM_Options, 32)) {
+						extTools_Assemble(OPM_modName, 32, Compiler_buildState);
+						Compiler_buildState = NIL;
+						Compiler_Remember(&Compiler_assembled);
+					} else {
+						if (!__IN(10, OPM_Options, 32)) {
+							if (__IN(20, OPM_Options, 32)) {
+								Compiler_Remember(&Compiler_unity);
+							} else {
+								extTools_Assemble(OPM_modName, 32, Compiler_buildState);
+								Compiler_buildState = NIL;
+								Compiler_Remember(&Compiler_assembled);
+							}
+						} else {
+							if (__IN(20, OPM_Options, 32)) {
+								Compiler_WriteUnityFile();
+							}
+							extTools_WaitAll();
+							Compiler_FindLocalObjectFiles((void*)linkfiles, 2048);
+							extTools_LinkMain((void*)OPM_modName, 32, __IN(15, OPM_Options, 32), linkfiles, 2048);
+							if (OPM_Profile == 'p') {
+								Compiler_ProfileRebuild((void*)linkfiles, 2048);
+							}
+						}
+					}
+				}
+				if (Compiler_buildState != NIL) {
+					Files_Register(Compiler_buildState);
+					Compiler_buildState = NIL;
+				}
+			}
+		}
+	}
+}
+
+static BOOLEAN Compiler_ReadRequest (INT64 c)
+{
+	INT32 n, m;
+	INT16 res;
+	struct {
+		ADDRESS len[1];
+		CHAR data[1];
+	} *old = NIL;
+	if (Compiler_request == NIL) {
+		Compiler_request = __NEWARR(NIL, 1, 1, 1, 1, ((ADDRESS)(4096)));
+	}
+	n = 0;
+	for (;;) {
+		if (n == Compiler_request->len[0]) {
+			old = (void*)Compiler_request;
+			Compiler_request = __NEWARR(NIL, 1, 1, 1, 1, ((ADDRESS)(2 * n)));
+			__MOVE((ADDRESS)&old->data[0], (ADDRESS)&Compiler_request->data[0], n);
+		}
+		res = Platform_Read(c, (ADDRESS)&Compiler_request->data[__X(n, Compiler_request->len[0])], Compiler_request->len[0] - n, &m);
+		if (res != 0 || m <= 0) {
+			return 0;
+		}
+		n += m;
+		if ((((n >= 2 && Compiler_request->data[__X(n - 1, Compiler_request->len[0])] == 0x00)) && Compiler_request->data[__X(n - 2, Compiler_request->len[0])] == 0x00)) {
+			return 1;
+		}
+	}
+	__RETCHK;
+}
+
+static void Compiler_Warm (CHAR *names, ADDRESS names__len)
+{
+	BOOLEAN done;
+	if (OPM_OpenPar()) {
+		OPM_Init(&done);
+		if (done) {
+			OPM_InitOptions();
+			Compiler_PropagateElementaryTypeSizes();
+			OPT_Warm(names, names__len);
+		}
+	}
+	Out_Flush();
+}
+
+static void Compiler_Handle (INT64 h, INT64 c)
+{
+	INT32 i, j, cwd, n, m;
+	INT64 r, w;
+	INT16 argc, res, status;
+	INT64 pid;
+	BOOLEAN console;
+	CHAR trailer[2];
+	CHAR buf[4096];
+	CHAR names[65536];
+	console = Compiler_request->data[0] == 't';
+	i = 0;
+	while (Compiler_request->data[__X(i, Compiler_request->len[0])] != 0x00) {
+		i += 1;
+	}
+	i += 1;
+	cwd = i;
+	while (Compiler_request->data[__X(i, Compiler_request->len[0])] != 0x00) {
+		i += 1;
+	}
+	i += 1;
+	n = i;
+	argc = 0;
+	while (Compiler_request->data[__X(i, Compiler_request->len[0])] != 0x00) {
+		while (Compiler_request->data[__X(i, Compiler_request->len[0])] != 0x00) {
+			i += 1;
+		}
+		argc += 1;
+		i += 1;
+	}
+	Compiler_argv = __NEWARR(NIL, 8, 8, 1, 1, ((ADDRESS)(argc + 1)));
+	i = n;
+	argc = 0;
+	while (Compiler_request->data[__X(i, Compiler_request->len[0])] != 0x00) {
+		Compiler_argv->data[__X(argc, Compiler_argv->len[0])] = (ADDRESS)&Compiler_request->data[__X(i, Compiler_request->len[0])];
+		while (Compiler_request->data[__X(i, Compiler_request->len[0])] != 0x00) {
+			i += 1;
+		}
+		argc += 1;
+		i += 1;
+	}
+	Modules_ArgCount = argc;
+	Modules_ArgVector = (ADDRESS)&Compiler_argv->data[0];
+	status = 512;
+	n = 0;
+	Out_Flush();
+	if ((Platform_Chdir((void*)&Compiler_request->data[__X(cwd, Compiler_request->len[0])], Compiler_request->len[0] - cwd) == 0 && Platform_Pipe(&r, &w) == 0)) {
+		if (Platform_Fork(&pid) != 0) {
+			res = Platform_Close(r);
+			res = Platform_Close(w);
+		} else if (pid == 0) {
+			res = Platform_Close(h);
+			res = Platform_Close(r);
+			Compiler_serving = 0;
+			Compiler_report = w;
+			res = Platform_Redirect(c, Platform_StdOut);
+			res = Platform_Redirect(c, Platform_StdErr);
+			res = Platform_Close(c);
+			Out_IsConsole = console;
+			Out_SetBuffer(65536, Out_IsConsole);
+			OPT_UseCache();
+			Compiler_Translate();
+			Heap_FINALL();
+			Platform_Exit(0);
+		} else {
+			res = Platform_Close(w);
+			for (;;) {
+				res = Platform_ReadBuf(r, (void*)buf, 4096, &m);
+				if (res != 0 || m <= 0) {
+					break;
+				}
+				j = 0;
+				while ((j < m && n < 65535)) {
+					names[__X(n, 65536)] = buf[__X(j, 4096)];
+					n += 1;
+					j += 1;
+				}
 			}
+			res = Platform_Close(r);
+			res = Platform_Wait(pid, &status);
 		}
 	}
+	names[__X(n, 65536)] = 0x00;
+	trailer[0] = 0x00;
+	if (__MASK(status, -128) != 0) {
+		trailer[1] = 0x02;
+	} else {
+		trailer[1] = (CHAR)__MASK(__ASHR(status, 8), -256);
+	}
+	res = Platform_Write(c, (ADDRESS)trailer, 2);
+	res = Platform_Close(c);
+	if (n > 0) {
+		Compiler_Warm((void*)names, 65536);
+	}
+}
+
+static void Compiler_Serve (void)
+{
+	INT64 h, c;
+	INT16 res;
+	Modules_GetArg(2, (void*)Compiler_socket, 256);
+	if (Platform_Connect(Compiler_socket, 256, &c) == 0) {
+		res = Platform_Close(c);
+		OPM_LogWStr((CHAR*)"A compile server is already listening at ", 42);
+		OPM_LogWStr(Compiler_socket, 256);
+		OPM_LogW('.');
+		OPM_LogWLn();
+		Heap_FINALL();
+		Platform_Exit(1);
+	}
+	res = Platform_Listen(Compiler_socket, 256, &h);
+	if (res != 0) {
+		OPM_LogWStr((CHAR*)"Cannot listen at ", 18);
+		OPM_LogWStr(Compiler_socket, 256);
+		OPM_LogWStr((CHAR*)", error ", 9);
+		OPM_LogWNum(res, 0);
+		OPM_LogW('.');
+		OPM_LogWLn();
+		Heap_FINALL();
+		Platform_Exit(1);
+	}
+	Compiler_serving = 1;
+	OPM_LogWStr((CHAR*)"Compile server listening at ", 29);
+	OPM_LogWStr(Compiler_socket, 256);
+	OPM_LogW('.');
+	OPM_LogWLn();
+	Out_Flush();
+	if (Platform_OldRW((CHAR*)"NUL", 4, &c) == 0) {
+		res = Platform_Redirect(c, Platform_StdOut);
+		res = Platform_Redirect(c, Platform_StdErr);
+		res = Platform_Close(c);
+	}
+	Platform_IgnoreBrokenPipe();
+	for (;;) {
+		if (Platform_Accept(h, &c) == 0) {
+			if (Compiler_ReadRequest(c)) {
+				Compiler_Handle(h, c);
+			} else {
+				res = Platform_Close(c);
+			}
+		}
+	}
+}
+
+static void Compiler_Append (CHAR *s, ADDRESS s__len, INT32 *n)
+{
+	INT32 i;
+	struct {
+		ADDRESS len[1];
+		CHAR data[1];
+	} *old = NIL;
+	i = 0;
+	do {
+		if (*n == Compiler_request->len[0]) {
+			old = (void*)Compiler_request;
+			Compiler_request = __NEWARR(NIL, 1, 1, 1, 1, ((ADDRESS)(2 * *n)));
+			__MOVE((ADDRESS)&old->data[0], (ADDRESS)&Compiler_request->data[0], *n);
+		}
+		Compiler_request->data[__X(*n, Compiler_request->len[0])] = s[__X(i, s__len)];
+		*n += 1;
+		i += 1;
+	} while (!(s[__X(i - 1, s__len)] == 0x00));
+}
+
+static void Compiler_Client (void)
+{
+	INT64 h;
+	INT32 n, k;
+	INT16 i, res;
+	CHAR arg[1024];
+	CHAR buf[4098];
+	Modules_GetArg(2, (void*)Compiler_socket, 256);
+	if (Platform_Connect(Compiler_socket, 256, &h) != 0) {
+		OPM_LogWStr((CHAR*)"No compile server at ", 22);
+		OPM_LogWStr(Compiler_socket, 256);
+		OPM_LogW('.');
+		OPM_LogWLn();
+		Heap_FINALL();
+		Platform_Exit(2);
+	}
+	Compiler_request = __NEWARR(NIL, 1, 1, 1, 1, ((ADDRESS)(4096)));
+	n = 0;
+	if (Out_IsConsole) {
+		Compiler_Append((CHAR*)"t", 2, &n);
+	} else {
+		Compiler_Append((CHAR*)"-", 2, &n);
+	}
+	Compiler_Append(Platform_CWD, 4096, &n);
+	Modules_GetArg(0, (void*)arg, 1024);
+	Compiler_Append(arg, 1024, &n);
+	i = 3;
+	while (i < Modules_ArgCount) {
+		Modules_GetArg(i, (void*)arg, 1024);
+		Compiler_Append(arg, 1024, &n);
+		i += 1;
+	}
+	Compiler_Append((CHAR*)"", 1, &n);
+	res = Platform_Write(h, (ADDRESS)&Compiler_request->data[0], n);
+	k = 0;
+	for (;;) {
+		res = Platform_Read(h, (ADDRESS)&buf[__X(k, 4098)], 4096, &n);
+		if (res != 0 || n <= 0) {
+			break;
+		}
+		n += k;
+		if (n > 2) {
+			res = Platform_Write(Platform_StdOut, (ADDRESS)buf, n - 2);
+			buf[0] = buf[__X(n - 2, 4098)];
+			buf[1] = buf[__X(n - 1, 4098)];
+			k = 2;
+		} else {
+			k = n;
+		}
+	}
+	res = Platform_Close(h);
+	if ((k == 2 && buf[0] == 0x00)) {
+		Platform_Exit((INT16)buf[1]);
+	}
+	res = Platform_Write(Platform_StdOut, (ADDRESS)buf, k);
+	OPM_LogWLn();
+	OPM_LogWStr((CHAR*)"Connection to compile server lost.", 35);
+	OPM_LogWLn();
+	Heap_FINALL();
+	Platform_Exit(2);
 }
 
 static void Compiler_Trap (INT32 sig)
 {
+	INT16 res;
+	if (Compiler_serving) {
+		res = Platform_Unlink(Compiler_socket, 256);
+	}
 	Heap_FINALL();
 	if (sig == 3) {
 		Platform_Exit(0);
@@ -186,28 +1042,50 @@ static void Compiler_Trap (INT32 sig)
 	}
 }
 
+static void EnumPtrs(void (*P)(void*))
+{
+	P(Compiler_unity);
+	P(Compiler_assembled);
+	P(Compiler_statsFile);
+	P(Compiler_buildState);
+	__ENUMR(&Compiler_stats, Files_Rider__typ, 24, 1, P);
+	P(Compiler_request);
+	P(Compiler_argv);
+}
+
 
 export int main(int argc, char **argv)
 {
 	__INIT(argc, argv);
 	__MODULE_IMPORT(Configuration);
+	__MODULE_IMPORT(Files);
 	__MODULE_IMPORT(Heap);
+	__MODULE_IMPORT(Modules);
 	__MODULE_IMPORT(OPB);
 	__MODULE_IMPORT(OPC);
 	__MODULE_IMPORT(OPM);
 	__MODULE_IMPORT(OPP);
+	__MODULE_IMPORT(OPS);
 	__MODULE_IMPORT(OPT);
 	__MODULE_IMPORT(OPV);
+	__MODULE_IMPORT(Out);
 	__MODULE_IMPORT(Platform);
 	__MODULE_IMPORT(Strings);
 	__MODULE_IMPORT(VT100);
 	__MODULE_IMPORT(extTools);
-	__REGMAIN("Compiler", 0);
+	__REGMAIN("Compiler", EnumPtrs);
 	__REGCMD("Translate", Compiler_Translate);
 /* BEGIN */
 	Platform_SetInterruptHandler(Compiler_Trap);
 	Platform_SetQuitHandler(Compiler_Trap);
 	Platform_SetBadInstructionHandler(Compiler_Trap);
-	Compiler_Translate();
+	Compiler_report = -1;
+	if ((Modules_ArgCount > 1 && Modules_ArgPos((CHAR*)"-D", 3) == 1)) {
+		Compiler_Serve();
+	} else if ((Modules_ArgCount > 1 && Modules_ArgPos((CHAR*)"-C", 3) == 1)) {
+		Compiler_Client();
+	} else {
+		Compiler_Translate();
+	}
 	__FINI;
 }
@@ -76,11 +76,13 @@ static void Files_Finalize (SYSTEM_PTR o);
 static void Files_FlipBytes (SYSTEM_BYTE *src, ADDRESS src__len, SYSTEM_BYTE *dest, ADDRESS dest__len);
 static void Files_Flush (Files_Buffer buf);
 export void Files_GetDate (Files_File f, INT32 *t, INT32 *d);
+export void Files_GetIdentity (Files_File f, Platform_FileIdentity *identity, ADDRESS *identity__typ);
 export void Files_GetName (Files_File f, CHAR *name, ADDRESS name__len);
 static void Files_GetTempName (CHAR *finalName, ADDRESS finalName__len, CHAR *name, ADDRESS name__len);
 static BOOLEAN Files_HasDir (CHAR *name, ADDRESS name__len);
 export INT32 Files_Length (Files_File f);
 static void Files_MakeFileName (CHAR *dir, ADDRESS dir__len, CHAR *name, ADDRESS name__len, CHAR *dest, ADDRESS dest__len);
+export void Files_Map (Files_File f, INT64 *adr, INT16 *res);
 export Files_File Files_New (CHAR *name, ADDRESS name__len);
 export Files_File Files_Old (CHAR *name, ADDRESS name__len);
 export INT32 Files_Pos (Files_Rider *r, ADDRESS *r__typ);
@@ -332,6 +334,12 @@ INT32 Files_Length (Files_File f)
 	return f->len;
 }
 
+void Files_Map (Files_File f, INT64 *adr, INT16 *res)
+{
+	Files_Create(f);
+	*res = Platform_MapFile(f->fd, f->len, &*adr);
+}
+
 Files_File Files_New (CHAR *name, ADDRESS name__len)
 {
 	Files_File f = NIL;
@@ -541,6 +549,13 @@ void Files_GetDate (Files_File f, INT32 *t, INT32 *d)
 	Platform_MTimeAsClock(identity, &*t, &*d);
 }
 
+void Files_GetIdentity (Files_File f, Platform_FileIdentity *identity, ADDRESS *identity__typ)
+{
+	INT16 error;
+	Files_Create(f);
+	error = Platform_Identify(f->fd, &*identity, identity__typ);
+}
+
 INT32 Files_Pos (Files_Rider *r, ADDRESS *r__typ)
 {
 	Files_Assert((*r).offset <= 4096);
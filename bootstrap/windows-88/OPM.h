@@ -4,8 +4,19 @@
 #define OPM__h
 
 #include "SYSTEM.h"
+#include "Platform.h"
 
+typedef
+	struct OPM_SymFileDesc *OPM_SymFile;
 
+typedef
+	struct OPM_SymFileDesc {
+		INT64 _prvt0;
+		char _prvt1[72];
+	} OPM_SymFileDesc;
+
+
+import CHAR OPM_SourceFileName[256];
 import CHAR OPM_Model[10];
 import INT16 OPM_AddressSize, OPM_Alignment;
 import UINT32 OPM_GlobalOptions, OPM_Options;
@@ -19,7 +30,12 @@ import CHAR OPM_modName[32];
 import CHAR OPM_objname[64];
 import CHAR OPM_InstallDir[1024];
 import CHAR OPM_ResourceDir[1024];
+import INT16 OPM_Jobs;
+import CHAR OPM_Profile;
+import INT32 OPM_nofBytes, OPM_nofLines;
+import INT32 OPM_phaseWall[5], OPM_phaseCpu[5];
 
+import ADDRESS *OPM_SymFileDesc__typ;
 
 import void OPM_CloseFiles (void);
 import void OPM_CloseOldSym (void);
@@ -42,23 +58,32 @@ import void OPM_LogWStr (CHAR *s, ADDRESS s__len);
 import INT32 OPM_Longint (INT64 n);
 import void OPM_Mark (INT16 n, INT32 pos);
 import void OPM_NewSym (CHAR *modName, ADDRESS modName__len);
-import void OPM_OldSym (CHAR *modName, ADDRESS modName__len, BOOLEAN *done);
+import void OPM_OldSym (CHAR *modName, ADDRESS modName__len, OPM_SymFile *sf);
 import void OPM_OpenFiles (CHAR *moduleName, ADDRESS moduleName__len);
 import BOOLEAN OPM_OpenPar (void);
 import void OPM_RegisterNewSym (void);
 import INT64 OPM_SignedMaximum (INT32 bytecount);
 import INT64 OPM_SignedMinimum (INT32 bytecount);
+import void OPM_StartPhase (INT16 p);
+import void OPM_StopPhase (INT16 p);
+import INT32 OPM_SymPos (void);
 import void OPM_SymRCh (CHAR *ch);
 import INT32 OPM_SymRInt (void);
 import INT64 OPM_SymRInt64 (void);
+import INT32 OPM_SymRLInt (void);
 import void OPM_SymRLReal (LONGREAL *lr);
 import void OPM_SymRReal (REAL *r);
 import void OPM_SymRSet (UINT64 *s);
+import void OPM_SymSelect (OPM_SymFile sf, INT32 pos);
+import void OPM_SymStamp (OPM_SymFile sf, Platform_FileIdentity *identity, ADDRESS *identity__typ, INT32 *len);
 import void OPM_SymWCh (CHAR ch);
 import void OPM_SymWInt (INT64 i);
+import void OPM_SymWLInt (INT32 i);
 import void OPM_SymWLReal (LONGREAL lr);
+import INT32 OPM_SymWPos (void);
 import void OPM_SymWReal (REAL r);
 import void OPM_SymWSet (UINT64 s);
+import void OPM_SymWSetPos (INT32 pos);
 import void OPM_Write (CHAR ch);
 import void OPM_WriteHex (INT64 i);
 import void OPM_WriteInt (INT64 i);
@@ -20,23 +20,35 @@ typedef
 static INT16 OPV_stamp;
 static OPV_ExitInfo OPV_exit;
 static INT16 OPV_nofExitLabels;
+static OPT_Object OPV_factVar[8], OPV_factLen[8];
+static INT64 OPV_factLow[8], OPV_factHigh[8];
+static INT16 OPV_nofFacts;
+export INT32 OPV_nofIndexChecks, OPV_nofRangeChecks, OPV_nofGuards, OPV_nofDivMods;
 
 export ADDRESS *OPV_ExitInfo__typ;
 
 static void OPV_ActualPar (OPT_Node n, OPT_Object fp);
 export void OPV_AdrAndSize (OPT_Object topScope);
 static void OPV_CaseStat (OPT_Node n, OPT_Object outerProc);
+static void OPV_CaseTest (OPT_Node x, OPT_Node label);
 static void OPV_Convert (OPT_Node n, OPT_Struct newtype, INT16 prec);
 static void OPV_DefineTDescs (OPT_Node n);
+static BOOLEAN OPV_Designates (OPT_Node n, OPT_Object v);
 static void OPV_Entier (OPT_Node n, INT16 prec);
+static void OPV_ForFact (OPT_Node n, OPT_Node init, OPT_Node limit);
 static void OPV_GetTProcNum (OPT_Object obj);
 static void OPV_IfStat (OPT_Node n, BOOLEAN withtrap, OPT_Object outerProc);
 static BOOLEAN OPV_ImplicitReturn (OPT_Node n);
+static BOOLEAN OPV_InRange (OPT_Node n, OPT_Node d, INT16 dim);
 static void OPV_Index (OPT_Node n, OPT_Node d, INT16 prec, INT16 dim);
 export void OPV_Init (void);
 static void OPV_InitTDescs (OPT_Node n);
 static void OPV_Len (OPT_Node n, INT64 dim);
+static BOOLEAN OPV_LenBound (OPT_Node n, OPT_Object *len, INT64 *k);
+static void OPV_MarkCopies (OPT_Object proc, OPT_Node body);
+static BOOLEAN OPV_Modifies (OPT_Node n, OPT_Node stop, OPT_Object v);
 export void OPV_Module (OPT_Node prog);
+static BOOLEAN OPV_Narrow (OPT_Node label);
 static void OPV_NewArr (OPT_Node d, OPT_Node x);
 static void OPV_ParIntLiteral (INT64 n, INT32 size);
 static INT16 OPV_Precedence (INT16 class, INT16 subclass, INT16 form, INT16 comp);
@@ -47,6 +59,8 @@ static OPT_Object OPV_SuperProc (OPT_Node n);
 static void OPV_Traverse (OPT_Object obj, OPT_Object outerScope, BOOLEAN exported);
 static void OPV_TraverseRecord (OPT_Struct typ);
 static void OPV_TypeOf (OPT_Node n);
+static OPT_Node OPV_Widened (OPT_Node n);
+static BOOLEAN OPV_Writes (OPT_Node n, OPT_Object par);
 static void OPV_design (OPT_Node n, INT16 prec);
 static void OPV_expr (OPT_Node n, INT16 prec);
 static void OPV_stat (OPT_Node n, OPT_Object outerProc);
@@ -56,6 +70,11 @@ void OPV_Init (void)
 {
 	OPV_stamp = 0;
 	OPV_nofExitLabels = 0;
+	OPV_nofIndexChecks = 0;
+	OPV_nofRangeChecks = 0;
+	OPV_nofGuards = 0;
+	OPV_nofDivMods = 0;
+	OPV_nofFacts = 0;
 }
 
 static void OPV_GetTProcNum (OPT_Object obj)
@@ -69,7 +88,7 @@ static void OPV_GetTProcNum (OPT_Object obj)
 	if (typ->form == 11) {
 		typ = typ->BaseTyp;
 	}
-	OPT_FindField(obj->name, typ->BaseTyp, &redef);
+	OPT_FindField(obj->name->data, typ->BaseTyp, &redef);
 	if (redef != NIL) {
 		obj->adr = __ASHL(__ASHR(redef->adr, 16), 16);
 		if (!__IN(2, obj->conval->setval, 64)) {
@@ -110,6 +129,16 @@ static void OPV_Stamp (OPS_Name s)
 	s[__X(i, 256)] = '_';
 	s[__X(i + 1, 256)] = '_';
 	i += 2;
+	if (__IN(20, OPM_Options, 32)) {
+		k = 0;
+		while (OPT_SelfName[__X(k, 256)] != 0x00) {
+			s[__X(i, 256)] = OPT_SelfName[__X(k, 256)];
+			i += 1;
+			k += 1;
+		}
+		s[__X(i, 256)] = '_';
+		i += 1;
+	}
 	k = 0;
 	do {
 		n[__X(k, 10)] = __CHR((int)__MOD(j, 10) + 48);
@@ -129,11 +158,14 @@ static void OPV_Traverse (OPT_Object obj, OPT_Object outerScope, BOOLEAN exporte
 	INT16 mode;
 	OPT_Object scope = NIL;
 	OPT_Struct typ = NIL;
+	OPS_Name name;
 	if (obj != NIL) {
 		OPV_Traverse(obj->left, outerScope, exported);
-		if (obj->name[0] == '@') {
-			obj->name[0] = '_';
-			OPV_Stamp(obj->name);
+		if ((obj->name->data)[0] == '@') {
+			__COPY(obj->name->data, name, 256);
+			name[0] = '_';
+			OPV_Stamp(name);
+			obj->name = OPS_Intern(name, 256);
 		}
 		obj->linkadr = 0;
 		mode = obj->mode;
@@ -153,7 +185,9 @@ static void OPV_Traverse (OPT_Object obj, OPT_Object outerScope, BOOLEAN exporte
 		}
 		if (!exported) {
 			if ((__IN(mode, 0x60, 32) && obj->mnolev > 0)) {
-				OPV_Stamp(obj->name);
+				__COPY(obj->name->data, name, 256);
+				OPV_Stamp(name);
+				obj->name = OPS_Intern(name, 256);
 			}
 			if (__IN(mode, 0x26, 32)) {
 				obj->scope = outerScope;
@@ -163,8 +197,9 @@ static void OPV_Traverse (OPT_Object obj, OPT_Object outerScope, BOOLEAN exporte
 				}
 				scope = obj->scope;
 				scope->leaf = 1;
-				__MOVE(obj->name, scope->name, 256);
-				OPV_Stamp(scope->name);
+				__COPY(obj->name->data, name, 256);
+				OPV_Stamp(name);
+				scope->name = OPS_Intern(name, 256);
 				if (mode == 9) {
 					obj->adr = 1;
 				}
@@ -367,6 +402,7 @@ static void OPV_Entier (OPT_Node n, INT16 prec)
 static void OPV_SizeCast (OPT_Node n, INT32 to)
 {
 	if ((to < n->typ->size && __IN(2, OPM_Options, 32))) {
+		OPV_nofRangeChecks += 1;
 		OPM_WriteString((CHAR*)"__SHORT", 8);
 		if (OPV_SideEffects(n)) {
 			OPM_Write('F');
@@ -405,6 +441,7 @@ static void OPV_Convert (OPT_Node n, OPT_Struct newtype, INT16 prec)
 		OPV_SizeCast(n, newtype->size);
 	} else if (to == 3) {
 		if (__IN(2, OPM_Options, 32)) {
+			OPV_nofRangeChecks += 1;
 			OPM_WriteString((CHAR*)"__CHR", 6);
 			if (OPV_SideEffects(n)) {
 				OPM_Write('F');
@@ -443,11 +480,229 @@ static void OPV_TypeOf (OPT_Node n)
 	}
 }
 
+static OPT_Node OPV_Widened (OPT_Node n)
+{
+	while ((((((((n->class == 11 && n->subcl == 20)) && n->typ->form == 4)) && n->left->typ->form == 4)) && n->left->typ->size <= n->typ->size)) {
+		n = n->left;
+	}
+	return n;
+}
+
+static BOOLEAN OPV_Designates (OPT_Node n, OPT_Object v)
+{
+	while ((((n != NIL && n->class == 11)) && n->subcl == 29)) {
+		n = n->left;
+	}
+	return (((n != NIL && n->class == 0)) && n->obj == v);
+}
+
+static BOOLEAN OPV_Modifies (OPT_Node n, OPT_Node stop, OPT_Object v)
+{
+	OPT_Node a = NIL;
+	OPT_Object fp = NIL;
+	while (n != stop) {
+		if (((n->class == 19 || (n->class == 11 && n->subcl == 24))) && OPV_Designates(n->left, v)) {
+			return 1;
+		}
+		if (n->class == 13) {
+			a = n->right;
+			fp = n->obj;
+			while (a != NIL) {
+				if (((fp == NIL || fp->mode == 2)) && OPV_Designates(a, v)) {
+					return 1;
+				}
+				if (fp != NIL) {
+					fp = fp->link;
+				}
+				a = a->link;
+			}
+		}
+		if (OPV_Modifies(n->left, NIL, v) || OPV_Modifies(n->right, NIL, v)) {
+			return 1;
+		}
+		n = n->link;
+	}
+	return 0;
+}
+
+static BOOLEAN OPV_Writes (OPT_Node n, OPT_Object par)
+{
+	OPT_Node x = NIL;
+	while (n != NIL) {
+		if (n->class == 13) {
+			return 1;
+		}
+		if (n->class == 19) {
+			if (__IN(n->subcl, 0x8e000000, 32)) {
+				return 1;
+			}
+			x = n->left;
+			while ((x != NIL && __IN(x->class, 0x74, 32))) {
+				x = x->left;
+			}
+			if (((x == NIL || x->class != 0) || x->obj == par) || x->obj->mnolev != par->mnolev) {
+				return 1;
+			}
+		}
+		if (OPV_Writes(n->left, par) || OPV_Writes(n->right, par)) {
+			return 1;
+		}
+		n = n->link;
+	}
+	return 0;
+}
+
+static void OPV_MarkCopies (OPT_Object proc, OPT_Node body)
+{
+	OPT_Object par = NIL;
+	par = proc->link;
+	while (par != NIL) {
+		par->nocopy = (((((__IN(par->typ->comp, 0x0c, 32) && par->mode == 1)) && par->leaf)) && !OPV_Writes(body, par));
+		par = par->link;
+	}
+}
+
+static BOOLEAN OPV_LenBound (OPT_Node n, OPT_Object *len, INT64 *k)
+{
+	n = OPV_Widened(n);
+	*k = 0;
+	if ((((n->class == 12 && n->subcl == 7)) && n->right->class == 7)) {
+		*k = n->right->conval->intval;
+		n = OPV_Widened(n->left);
+	}
+	if ((((((((n->class == 12 && n->subcl == 19)) && n->right->conval->intval == 0)) && __IN(n->left->class, 0x03, 32))) && n->left->typ->comp == 3)) {
+		*len = n->left->obj;
+		return 1;
+	}
+	return 0;
+}
+
+static void OPV_ForFact (OPT_Node n, OPT_Node init, OPT_Node limit)
+{
+	OPT_Node cond = NIL, s = NIL, lo = NIL, hi = NIL;
+	OPT_Object v = NIL, len = NIL;
+	INT64 step, low, high, k;
+	BOOLEAN strict;
+	cond = n->left;
+	if ((OPV_nofFacts == 8 || init == NIL) || n->right == NIL) {
+		return;
+	}
+	if (!(((cond->class == 12 && __IN(cond->subcl, 0x7800, 32))) && cond->left->class == 0)) {
+		return;
+	}
+	v = cond->left->obj;
+	if (!(((v->mode == 1 && v->mnolev > 0)) && v->leaf)) {
+		return;
+	}
+	if (!(((((init->class == 19 && init->subcl == 0)) && init->left->class == 0)) && init->left->obj == v)) {
+		return;
+	}
+	s = n->right;
+	while (s->link != NIL) {
+		s = s->link;
+	}
+	if (!(((((((s->class == 19 && s->subcl == 13)) && s->left->class == 0)) && s->left->obj == v)) && s->right->class == 7)) {
+		return;
+	}
+	if (OPV_Modifies(n->right, s, v)) {
+		return;
+	}
+	step = s->right->conval->intval;
+	strict = __IN(cond->subcl, 0x2800, 32);
+	lo = OPV_Widened(init->right);
+	hi = OPV_Widened(cond->right);
+	if ((((((((((((((((((hi->class == 0 && limit != NIL)) && limit->class == 19)) && limit->subcl == 0)) && limit->left->class == 0)) && limit->left->obj == hi->obj)) && hi->obj->mode == 1)) && hi->obj->mnolev > 0)) && hi->obj->leaf)) && !OPV_Modifies(n->right, NIL, hi->obj))) {
+		hi = OPV_Widened(limit->right);
+	}
+	high = 0;
+	if ((step > 0 && __IN(cond->subcl, 0x1800, 32))) {
+		if (lo->class != 7) {
+			return;
+		}
+		low = lo->conval->intval;
+		if (hi->class == 7) {
+			high = hi->conval->intval;
+			if (strict) {
+				high -= 1;
+			}
+			if (high > OPM_SignedMaximum(v->typ->size) - step) {
+				return;
+			}
+		} else if (OPV_LenBound(hi, &len, &k)) {
+			if (strict) {
+				k += 1;
+			}
+			if (k < 1 || step > k) {
+				return;
+			}
+		} else {
+			return;
+		}
+	} else if ((step < 0 && __IN(cond->subcl, 0x6000, 32))) {
+		if (hi->class != 7) {
+			return;
+		}
+		low = hi->conval->intval;
+		if (strict) {
+			low += 1;
+		}
+		if (lo->class == 7) {
+			high = lo->conval->intval;
+		} else if (OPV_LenBound(lo, &len, &k)) {
+			if (k < 1) {
+				return;
+			}
+		} else {
+			return;
+		}
+	} else {
+		return;
+	}
+	if (low >= 0) {
+		OPV_factVar[__X(OPV_nofFacts, 8)] = v;
+		OPV_factLen[__X(OPV_nofFacts, 8)] = len;
+		OPV_factLow[__X(OPV_nofFacts, 8)] = low;
+		OPV_factHigh[__X(OPV_nofFacts, 8)] = high;
+		OPV_nofFacts += 1;
+	}
+}
+
+static BOOLEAN OPV_InRange (OPT_Node n, OPT_Node d, INT16 dim)
+{
+	OPT_Node x = NIL;
+	INT64 len;
+	INT16 i;
+	x = OPV_Widened(n->right);
+	len = -1;
+	if (n->left->typ->comp == 2) {
+		len = n->left->typ->n;
+	}
+	if ((((x->class == 11 && x->subcl == 20)) && x->left->typ->form == 3)) {
+		return len > 255;
+	} else if ((((x->class == 12 && x->subcl == 4)) && x->right->class == 7)) {
+		return (x->right->conval->intval > 0 && x->right->conval->intval <= len);
+	} else if (x->class == 0) {
+		i = OPV_nofFacts;
+		while (i > 0) {
+			i -= 1;
+			if (OPV_factVar[__X(i, 8)] == x->obj) {
+				if (OPV_factLen[__X(i, 8)] == NIL) {
+					return OPV_factHigh[__X(i, 8)] < len;
+				} else {
+					return (((dim == 0 && __IN(d->class, 0x03, 32))) && d->obj == OPV_factLen[__X(i, 8)]);
+				}
+			}
+		}
+	}
+	return 0;
+}
+
 static void OPV_Index (OPT_Node n, OPT_Node d, INT16 prec, INT16 dim)
 {
-	if (!__IN(0, OPM_Options, 32) || (n->right->class == 7 && (n->right->conval->intval == 0 || n->left->typ->comp != 3))) {
+	if (((!__IN(0, OPM_Options, 32) || n->nocheck) || (n->right->class == 7 && (n->right->conval->intval == 0 || n->left->typ->comp != 3))) || OPV_InRange(n, d, dim)) {
 		OPV_expr(n->right, prec);
 	} else {
+		OPV_nofIndexChecks += 1;
 		if (OPV_SideEffects(n->right)) {
 			OPM_WriteString((CHAR*)"__XF(", 6);
 		} else {
@@ -471,6 +726,9 @@ static void OPV_design (OPT_Node n, INT16 prec)
 	obj = n->obj;
 	class = n->class;
 	designPrec = OPV_Precedence(class, n->subcl, n->typ->form, comp);
+	if ((class == 5 && n->nocheck)) {
+		designPrec = 9;
+	}
 	if ((((((class == 0 && obj->mnolev > 0)) && (INT16)obj->mnolev != OPM_level)) && prec == 10)) {
 		designPrec = 9;
 	}
@@ -567,11 +825,12 @@ static void OPV_design (OPT_Node n, INT16 prec)
 		case 5: 
 			typ = n->typ;
 			obj = n->left->obj;
-			if (__IN(3, OPM_Options, 32)) {
+			if ((__IN(3, OPM_Options, 32) && !n->nocheck)) {
+				OPV_nofGuards += 1;
 				if (typ->comp == 4) {
 					OPM_WriteString((CHAR*)"__GUARDR(", 10);
 					if ((INT16)obj->mnolev != OPM_level) {
-						OPM_WriteStringVar((void*)obj->scope->name, 256);
+						OPM_WriteStringVar((void*)obj->scope->name->data, obj->scope->name->len[0]);
 						OPM_WriteString((CHAR*)"__curr->", 9);
 						OPC_Ident(obj);
 					} else {
@@ -607,6 +866,7 @@ static void OPV_design (OPT_Node n, INT16 prec)
 			break;
 		case 6: 
 			if (__IN(3, OPM_Options, 32)) {
+				OPV_nofGuards += 1;
 				if (n->left->class == 1) {
 					OPM_WriteString((CHAR*)"__GUARDEQR(", 12);
 					OPC_CompleteIdent(n->left->obj);
@@ -733,7 +993,7 @@ static OPT_Object OPV_SuperProc (OPT_Node n)
 	if (typ->form == 11) {
 		typ = typ->BaseTyp;
 	}
-	OPT_FindField(n->left->obj->name, typ->BaseTyp, &obj);
+	OPT_FindField(n->left->obj->name->data, typ->BaseTyp, &obj);
 	return obj;
 }
 
@@ -910,6 +1170,7 @@ static void OPV_expr (OPT_Node n, INT16 prec)
 							}
 							break;
 						case 3: 
+							OPV_nofDivMods += 1;
 							if (OPV_SideEffects(n)) {
 								if (n->typ->size <= 4) {
 									OPM_WriteString((CHAR*)"(int)", 6);
@@ -920,6 +1181,7 @@ static void OPV_expr (OPT_Node n, INT16 prec)
 							}
 							break;
 						case 4: 
+							OPV_nofDivMods += 1;
 							if (n->typ->size <= 4) {
 								OPM_WriteString((CHAR*)"(int)", 6);
 							}
@@ -1076,7 +1338,7 @@ static void OPV_IfStat (OPT_Node n, BOOLEAN withtrap, OPT_Object outerProc)
 				OPC_BegStat();
 				OPC_Ident(if_->left->obj);
 				OPM_WriteString((CHAR*)" *", 3);
-				OPM_WriteString(obj->name, 256);
+				OPM_WriteString(obj->name->data, obj->name->len[0]);
 				OPM_WriteString((CHAR*)"__ = (void*)", 13);
 				obj->adr = 0;
 				OPC_CompleteIdent(obj);
@@ -1108,51 +1370,134 @@ static void OPV_IfStat (OPT_Node n, BOOLEAN withtrap, OPT_Object outerProc)
 	}
 }
 
+static BOOLEAN OPV_Narrow (OPT_Node label)
+{
+	while (label != NIL) {
+		if (label->conval->intval2 - label->conval->intval >= 64) {
+			return 0;
+		}
+		label = label->link;
+	}
+	return 1;
+}
+
+static void OPV_CaseTest (OPT_Node x, OPT_Node label)
+{
+	INT64 low, high;
+	OPM_Write('(');
+	while (label != NIL) {
+		low = label->conval->intval;
+		high = label->conval->intval2;
+		if (low == high) {
+			OPV_expr(x, 9);
+			OPM_WriteString((CHAR*)" == ", 5);
+			OPM_WriteInt(low);
+		} else {
+			OPM_Write('(');
+			OPV_expr(x, 9);
+			OPM_WriteString((CHAR*)" >= ", 5);
+			OPM_WriteInt(low);
+			OPM_WriteString((CHAR*)" && ", 5);
+			OPV_expr(x, 9);
+			OPM_WriteString((CHAR*)" <= ", 5);
+			OPM_WriteInt(high);
+			OPM_Write(')');
+		}
+		label = label->link;
+		if (label != NIL) {
+			OPM_WriteString((CHAR*)" || ", 5);
+		}
+	}
+	OPM_Write(')');
+}
+
 static void OPV_CaseStat (OPT_Node n, OPT_Object outerProc)
 {
 	OPT_Node switchCase = NIL, label = NIL;
 	INT64 low, high;
 	INT16 form, i;
+	BOOLEAN wide;
 	OPM_WriteString((CHAR*)"switch ", 8);
 	OPV_expr(n->left, 12);
 	OPM_Write(' ');
 	OPC_BegBlk();
 	form = n->left->typ->form;
+	wide = 0;
+	if (!OPV_SideEffects(n->left)) {
+		switchCase = n->right->left;
+		while (switchCase != NIL) {
+			if (!OPV_Narrow(switchCase->left)) {
+				wide = 1;
+			}
+			switchCase = switchCase->link;
+		}
+	}
 	switchCase = n->right->left;
 	while (switchCase != NIL) {
-		label = switchCase->left;
-		i = 0;
-		while (label != NIL) {
-			low = label->conval->intval;
-			high = label->conval->intval2;
-			while (low <= high) {
-				if (i == 0) {
-					OPC_BegStat();
-				}
-				OPC_Case(low, form);
-				low += 1;
-				i += 1;
-				if (i == 5) {
-					OPM_WriteLn();
-					i = 0;
+		if (!wide || OPV_Narrow(switchCase->left)) {
+			label = switchCase->left;
+			i = 0;
+			while (label != NIL) {
+				low = label->conval->intval;
+				high = label->conval->intval2;
+				while (low <= high) {
+					if (i == 0) {
+						OPC_BegStat();
+					}
+					OPC_Case(low, form);
+					low += 1;
+					i += 1;
+					if (i == 5) {
+						OPM_WriteLn();
+						i = 0;
+					}
 				}
+				label = label->link;
 			}
-			label = label->link;
-		}
-		if (i > 0) {
-			OPM_WriteLn();
+			if (i > 0) {
+				OPM_WriteLn();
+			}
+			OPC_Indent(1);
+			OPV_stat(switchCase->right, outerProc);
+			OPC_BegStat();
+			OPM_WriteString((CHAR*)"break", 6);
+			OPC_EndStat();
+			OPC_Indent(-1);
 		}
-		OPC_Indent(1);
-		OPV_stat(switchCase->right, outerProc);
-		OPC_BegStat();
-		OPM_WriteString((CHAR*)"break", 6);
-		OPC_EndStat();
-		OPC_Indent(-1);
 		switchCase = switchCase->link;
 	}
 	OPC_BegStat();
 	OPM_WriteString((CHAR*)"default: ", 10);
-	if (n->right->conval->setval != 0x0) {
+	if (wide) {
+		OPC_Indent(1);
+		OPM_WriteLn();
+		OPC_BegStat();
+		switchCase = n->right->left;
+		while (switchCase != NIL) {
+			if (!OPV_Narrow(switchCase->left)) {
+				OPM_WriteString((CHAR*)"if ", 4);
+				OPV_CaseTest(n->left, switchCase->left);
+				OPM_Write(' ');
+				OPC_BegBlk();
+				OPV_stat(switchCase->right, outerProc);
+				OPC_EndBlk0();
+				OPM_WriteString((CHAR*)" else ", 7);
+			}
+			switchCase = switchCase->link;
+		}
+		OPC_BegBlk();
+		if (n->right->conval->setval != 0x0) {
+			OPV_stat(n->right->right, outerProc);
+		} else {
+			OPC_BegStat();
+			OPM_WriteString((CHAR*)"__CASECHK", 10);
+			OPC_EndStat();
+		}
+		OPC_EndBlk();
+		OPC_BegStat();
+		OPM_WriteString((CHAR*)"break", 6);
+		OPC_Indent(-1);
+	} else if (n->right->conval->setval != 0x0) {
 		OPC_Indent(1);
 		OPM_WriteLn();
 		OPV_stat(n->right->right, outerProc);
@@ -1248,7 +1593,8 @@ static void OPV_stat (OPT_Node n, OPT_Object outerProc)
 {
 	OPT_Object proc = NIL;
 	OPV_ExitInfo saved;
-	OPT_Node l = NIL, r = NIL;
+	OPT_Node l = NIL, r = NIL, last = NIL, before = NIL;
+	INT16 facts;
 	while ((n != NIL && OPM_noerr)) {
 		OPM_errpos = OPM_Longint(n->conval->intval);
 		if (n->class != 14) {
@@ -1277,6 +1623,7 @@ static void OPV_stat (OPT_Node n, OPT_Object outerProc)
 					OPM_level += 1;
 					OPV_stat(n->left, proc);
 					OPM_level -= 1;
+					OPV_MarkCopies(proc, n->right);
 					OPC_EnterProc(proc);
 					OPV_stat(n->right, proc);
 					OPC_ExitProc(proc, 1, OPV_ImplicitReturn(n->right));
@@ -1298,6 +1645,7 @@ static void OPV_stat (OPT_Node n, OPT_Object outerProc)
 							if (r->typ == OPT_stringtyp) {
 								OPM_WriteInt(r->conval->intval2);
 							} else if (r->typ->comp == 3) {
+								OPV_nofIndexChecks += 1;
 								OPM_WriteString((CHAR*)"__X(", 5);
 								OPC_Len(r->obj, r->typ, 0);
 								OPM_WriteString((CHAR*)" * ", 4);
@@ -1460,7 +1808,10 @@ static void OPV_stat (OPT_Node n, OPT_Object outerProc)
 				OPV_expr(n->left, 12);
 				OPM_Write(' ');
 				OPC_BegBlk();
+				facts = OPV_nofFacts;
+				OPV_ForFact(n, last, before);
 				OPV_stat(n->right, outerProc);
+				OPV_nofFacts = facts;
 				OPC_EndBlk();
 				OPV_exit.level -= 1;
 				break;
@@ -1554,6 +1905,8 @@ static void OPV_stat (OPT_Node n, OPT_Object outerProc)
 		if (!__IN(n->class, 0x09744000, 32)) {
 			OPC_EndStat();
 		}
+		before = last;
+		last = n;
 		n = n->link;
 	}
 }
@@ -1568,6 +1921,12 @@ void OPV_Module (OPT_Node prog)
 	OPV_stat(prog, NIL);
 }
 
+static void EnumPtrs(void (*P)(void*))
+{
+	__ENUMP(OPV_factVar, 8, P);
+	__ENUMP(OPV_factLen, 8, P);
+}
+
 __TDESC(OPV_ExitInfo, 1, 0) = {__TDFLDS("ExitInfo", 4), {-8}};
 
 export void *OPV__init(void)
@@ -1577,7 +1936,7 @@ export void *OPV__init(void)
 	__MODULE_IMPORT(OPM);
 	__MODULE_IMPORT(OPS);
 	__MODULE_IMPORT(OPT);
-	__REGMOD("OPV", 0);
+	__REGMOD("OPV", EnumPtrs);
 	__REGCMD("Init", OPV_Init);
 	__INITYP(OPV_ExitInfo, OPV_ExitInfo, 0);
 /* BEGIN */
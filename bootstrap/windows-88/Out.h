@@ -17,6 +17,7 @@ import void Out_Ln (void);
 import void Out_LongReal (LONGREAL x, INT16 n);
 import void Out_Open (void);
 import void Out_Real (REAL x, INT16 n);
+import void Out_SetBuffer (INT32 size, BOOLEAN lineBuffered);
 import void Out_String (CHAR *str, ADDRESS str__len);
 import LONGREAL Out_Ten (INT16 e);
 import void *Out__init(void);
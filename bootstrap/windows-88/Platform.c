@@ -27,33 +27,43 @@ export CHAR Platform_NL[3];
 export ADDRESS *Platform_FileIdentity__typ;
 
 export BOOLEAN Platform_Absent (INT16 e);
+export INT16 Platform_Accept (INT64 h, INT64 *c);
 export INT16 Platform_Chdir (CHAR *n, ADDRESS n__len);
 export INT16 Platform_Close (INT64 h);
+export INT16 Platform_Connect (CHAR *n, ADDRESS n__len, INT64 *h);
 export BOOLEAN Platform_ConnectionFailed (INT16 e);
+export INT32 Platform_CpuTime (void);
 export void Platform_Delay (INT32 ms);
 export BOOLEAN Platform_DifferentFilesystems (INT16 e);
 static void Platform_EnableVT100 (void);
 export INT16 Platform_Error (void);
 export void Platform_Exit (INT32 code);
+export INT16 Platform_Fork (INT64 *pid);
 export void Platform_GetClock (INT32 *t, INT32 *d);
 export void Platform_GetEnv (CHAR *var, ADDRESS var__len, CHAR *val, ADDRESS val__len);
 export void Platform_GetTimeOfDay (INT32 *sec, INT32 *usec);
 export INT16 Platform_Identify (INT64 h, Platform_FileIdentity *identity, ADDRESS *identity__typ);
 export INT16 Platform_IdentifyByName (CHAR *n, ADDRESS n__len, Platform_FileIdentity *identity, ADDRESS *identity__typ);
+export void Platform_IgnoreBrokenPipe (void);
 export BOOLEAN Platform_Inaccessible (INT16 e);
 export BOOLEAN Platform_Interrupted (INT16 e);
 export BOOLEAN Platform_IsConsole (INT64 h);
+export INT16 Platform_Listen (CHAR *n, ADDRESS n__len, INT64 *h);
 export void Platform_MTimeAsClock (Platform_FileIdentity i, INT32 *t, INT32 *d);
+export INT16 Platform_MapFile (INT64 h, INT32 l, INT64 *adr);
 export INT16 Platform_MaxNameLength (void);
 export INT16 Platform_MaxPathLength (void);
+export INT32 Platform_MaxRSS (void);
 export INT16 Platform_New (CHAR *n, ADDRESS n__len, INT64 *h);
 export BOOLEAN Platform_NoSuchDirectory (INT16 e);
 export INT64 Platform_OSAllocate (INT64 size);
 export void Platform_OSFree (INT64 address);
 export INT16 Platform_OldRO (CHAR *n, ADDRESS n__len, INT64 *h);
 export INT16 Platform_OldRW (CHAR *n, ADDRESS n__len, INT64 *h);
+export INT16 Platform_Pipe (INT64 *r, INT64 *w);
 export INT16 Platform_Read (INT64 h, INT64 p, INT32 l, INT32 *n);
 export INT16 Platform_ReadBuf (INT64 h, SYSTEM_BYTE *b, ADDRESS b__len, INT32 *n);
+export INT16 Platform_Redirect (INT64 h, INT64 to);
 export INT16 Platform_Rename (CHAR *o, ADDRESS o__len, CHAR *n, ADDRESS n__len);
 export BOOLEAN Platform_SameFile (Platform_FileIdentity i1, Platform_FileIdentity i2);
 export BOOLEAN Platform_SameFileTime (Platform_FileIdentity i1, Platform_FileIdentity i2);
@@ -61,6 +71,7 @@ export INT16 Platform_Seek (INT64 h, INT32 o, INT16 r);
 export void Platform_SetBadInstructionHandler (Platform_SignalHandler handler);
 export void Platform_SetMTime (Platform_FileIdentity *target, ADDRESS *target__typ, Platform_FileIdentity source);
 export INT16 Platform_Size (INT64 h, INT32 *l);
+export INT16 Platform_Spawn (CHAR *cmd, ADDRESS cmd__len, INT64 *pid);
 export INT16 Platform_Sync (INT64 h);
 export INT16 Platform_System (CHAR *cmd, ADDRESS cmd__len);
 static void Platform_TestLittleEndian (void);
@@ -69,11 +80,14 @@ export BOOLEAN Platform_TimedOut (INT16 e);
 export BOOLEAN Platform_TooManyFiles (INT16 e);
 export INT16 Platform_Truncate (INT64 h, INT32 limit);
 export INT16 Platform_Unlink (CHAR *n, ADDRESS n__len);
+export INT16 Platform_UnmapFile (INT64 adr, INT32 l);
+export INT16 Platform_Wait (INT64 pid, INT16 *status);
 export INT16 Platform_Write (INT64 h, INT64 p, INT32 l);
 static void Platform_YMDHMStoClock (INT16 ye, INT16 mo, INT16 da, INT16 ho, INT16 mi, INT16 se, INT32 *t, INT32 *d);
 export BOOLEAN Platform_getEnv (CHAR *var, ADDRESS var__len, CHAR *val, ADDRESS val__len);
 
 #include "WindowsWrapper.h"
+#include <psapi.h>
 #define Platform_ECONNABORTED()	WSAECONNABORTED
 #define Platform_ECONNREFUSED()	WSAECONNREFUSED
 #define Platform_EHOSTUNREACH()	WSAEHOSTUNREACH
@@ -83,6 +97,7 @@ export BOOLEAN Platform_getEnv (CHAR *var, ADDRESS var__len, CHAR *val, ADDRESS
 #define Platform_ERRORFILENOTFOUND()	ERROR_FILE_NOT_FOUND
 #define Platform_ERRORNOTREADY()	ERROR_NOT_READY
 #define Platform_ERRORNOTSAMEDEVICE()	ERROR_NOT_SAME_DEVICE
+#define Platform_ERRORNOTSUPPORTED()	ERROR_NOT_SUPPORTED
 #define Platform_ERRORPATHNOTFOUND()	ERROR_PATH_NOT_FOUND
 #define Platform_ERRORSHARINGVIOLATION()	ERROR_SHARING_VIOLATION
 #define Platform_ERRORTOOMANYOPENFILES()	ERROR_TOO_MANY_OPEN_FILES
@@ -103,6 +118,10 @@ export BOOLEAN Platform_getEnv (CHAR *var, ADDRESS var__len, CHAR *val, ADDRESS
 #define Platform_byHandleFileInformation()	BY_HANDLE_FILE_INFORMATION bhfi
 #define Platform_cleanupProcess()	CloseHandle(pi.hProcess); CloseHandle(pi.hThread);
 #define Platform_closeHandle(h)	(INTEGER)CloseHandle((HANDLE)h)
+#define Platform_closeThread()	CloseHandle(pi.hThread)
+#define Platform_cpuTimeMs()	(LONGINT)(((((UINT64)kt.dwHighDateTime << 32) | kt.dwLowDateTime) + (((UINT64)ut.dwHighDateTime << 32) | ut.dwLowDateTime)) / 10000)
+#define Platform_cpuTimes()	FILETIME ct, et, kt, ut; GetProcessTimes(GetCurrentProcess(), &ct, &et, &kt, &ut)
+#define Platform_createFileMapping(h)	(ADDRESS)CreateFileMapping((HANDLE)(ADDRESS)h, 0, PAGE_READONLY, 0, 0, 0)
 #define Platform_createProcess(str, str__len)	(INTEGER)CreateProcess(0, (char*)str, 0,0,0,0,0,0,&si,&pi)
 #define Platform_deleteFile(n, n__len)	(INTEGER)DeleteFile((char*)n)
 #define Platform_err()	(INTEGER)GetLastError()
@@ -112,6 +131,7 @@ export BOOLEAN Platform_getEnv (CHAR *var, ADDRESS var__len, CHAR *val, ADDRESS
 #define Platform_free(address)	HeapFree(GetProcessHeap(), 0, (void*)address)
 #define Platform_ftToUli()	ULARGE_INTEGER ul; ul.LowPart=ft.dwLowDateTime; ul.HighPart=ft.dwHighDateTime
 #define Platform_getCurrentDirectory(n, n__len)	GetCurrentDirectory(n__len, (char*)n)
+#define Platform_getExitCodeHandle(h, exitcode)	GetExitCodeProcess((HANDLE)(ADDRESS)h, (DWORD*)exitcode)
 #define Platform_getExitCodeProcess(exitcode)	GetExitCodeProcess(pi.hProcess, (DWORD*)exitcode);
 #define Platform_getFileInformationByHandle(h)	(INTEGER)GetFileInformationByHandle((HANDLE)h, &bhfi)
 #define Platform_getFilePos(h, r, rc)	LARGE_INTEGER liz = {0}; *rc = (INTEGER)SetFilePointerEx((HANDLE)h, liz, &li, FILE_CURRENT); *r = (LONGINT)li.QuadPart
@@ -126,10 +146,14 @@ export BOOLEAN Platform_getEnv (CHAR *var, ADDRESS var__len, CHAR *val, ADDRESS
 #define Platform_invalidHandleValue()	((ADDRESS)INVALID_HANDLE_VALUE)
 #define Platform_largeInteger()	LARGE_INTEGER li
 #define Platform_liLongint()	(LONGINT)li.QuadPart
+#define Platform_mapViewOfFile(m)	(ADDRESS)MapViewOfFile((HANDLE)m, FILE_MAP_READ, 0, 0, 0)
+#define Platform_memoryCounters()	PROCESS_MEMORY_COUNTERS pmc = {0}; K32GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))
 #define Platform_moveFile(o, o__len, n, n__len)	(INTEGER)MoveFileEx((char*)o, (char*)n, MOVEFILE_REPLACE_EXISTING)
 #define Platform_opennew(n, n__len)	(ADDRESS)CreateFile((char*)n, GENERIC_READ|GENERIC_WRITE, FILE_SHARE_READ|FILE_SHARE_WRITE|FILE_SHARE_DELETE, 0, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, 0)
 #define Platform_openro(n, n__len)	(ADDRESS)CreateFile((char*)n, GENERIC_READ              , FILE_SHARE_READ|FILE_SHARE_WRITE|FILE_SHARE_DELETE, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0)
 #define Platform_openrw(n, n__len)	(ADDRESS)CreateFile((char*)n, GENERIC_READ|GENERIC_WRITE, FILE_SHARE_READ|FILE_SHARE_WRITE|FILE_SHARE_DELETE, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0)
+#define Platform_pmcPeakWorkingSet()	(LONGINT)(pmc.PeakWorkingSetSize / 1024)
+#define Platform_processHandle()	(INT64)(ADDRESS)pi.hProcess
 #define Platform_processInfo()	PROCESS_INFORMATION pi = {0};
 #define Platform_readfile(fd, p, l, n)	(INTEGER)ReadFile((HANDLE)fd, (void*)p, (DWORD)l, (DWORD*)n, 0)
 #define Platform_seekcur()	FILE_CURRENT
@@ -151,6 +175,8 @@ export BOOLEAN Platform_getEnv (CHAR *var, ADDRESS var__len, CHAR *val, ADDRESS
 #define Platform_tous1970()	ul.QuadPart = (ul.QuadPart - 116444736000000000ULL)/10LL
 #define Platform_ulSec()	(LONGINT)(ul.QuadPart / 1000000LL)
 #define Platform_uluSec()	(LONGINT)(ul.QuadPart % 1000000LL)
+#define Platform_unmapViewOfFile(a)	(INTEGER)UnmapViewOfFile((void*)(ADDRESS)a)
+#define Platform_waitForHandle(h)	(INTEGER)WaitForSingleObject((HANDLE)(ADDRESS)h, INFINITE)
 #define Platform_waitForProcess()	(INTEGER)WaitForSingleObject(pi.hProcess, INFINITE)
 #define Platform_writefile(fd, p, l, n)	(INTEGER)WriteFile((HANDLE)fd, (void*)(p), (DWORD)l, (DWORD*)n, 0)
 
@@ -263,6 +289,18 @@ INT32 Platform_Time (void)
 	return (int)__MOD(ms - Platform_TimeStart, 2147483647);
 }
 
+INT32 Platform_CpuTime (void)
+{
+	Platform_cpuTimes();
+	return Platform_cpuTimeMs();
+}
+
+INT32 Platform_MaxRSS (void)
+{
+	Platform_memoryCounters();
+	return Platform_pmcPeakWorkingSet();
+}
+
 void Platform_Delay (INT32 ms)
 {
 	while (ms > 30000) {
@@ -301,6 +339,69 @@ INT16 Platform_System (CHAR *cmd, ADDRESS cmd__len)
 	return __ASHL(result, 8);
 }
 
+INT16 Platform_Spawn (CHAR *cmd, ADDRESS cmd__len, INT64 *pid)
+{
+	__DUP(cmd, cmd__len, CHAR);
+	Platform_startupInfo();
+	Platform_processInfo();
+	if (Platform_createProcess(cmd, cmd__len) == 0) {
+		__DEL(cmd);
+		return Platform_err();
+	}
+	Platform_closeThread();
+	*pid = Platform_processHandle();
+	__DEL(cmd);
+	return 0;
+}
+
+INT16 Platform_Wait (INT64 pid, INT16 *status)
+{
+	INT32 result;
+	result = 127;
+	if (Platform_waitForHandle(pid) != 0) {
+		return Platform_err();
+	}
+	Platform_getExitCodeHandle(pid, &result);
+	Platform_closeHandle((ADDRESS)pid);
+	*status = (INT16)__ASHL(result, 8);
+	return 0;
+}
+
+INT16 Platform_Fork (INT64 *pid)
+{
+	*pid = 0;
+	return Platform_ERRORNOTSUPPORTED();
+}
+
+INT16 Platform_Pipe (INT64 *r, INT64 *w)
+{
+	return Platform_ERRORNOTSUPPORTED();
+}
+
+INT16 Platform_Redirect (INT64 h, INT64 to)
+{
+	return Platform_ERRORNOTSUPPORTED();
+}
+
+void Platform_IgnoreBrokenPipe (void)
+{
+}
+
+INT16 Platform_Listen (CHAR *n, ADDRESS n__len, INT64 *h)
+{
+	return Platform_ERRORNOTSUPPORTED();
+}
+
+INT16 Platform_Accept (INT64 h, INT64 *c)
+{
+	return Platform_ERRORNOTSUPPORTED();
+}
+
+INT16 Platform_Connect (CHAR *n, ADDRESS n__len, INT64 *h)
+{
+	return Platform_ERRORNOTSUPPORTED();
+}
+
 INT16 Platform_Error (void)
 {
 	return Platform_err();
@@ -418,6 +519,30 @@ INT16 Platform_Size (INT64 h, INT32 *l)
 	return 0;
 }
 
+INT16 Platform_MapFile (INT64 h, INT32 l, INT64 *adr)
+{
+	INT64 m;
+	m = Platform_createFileMapping(h);
+	if (m == 0) {
+		*adr = 0;
+		return Platform_err();
+	}
+	*adr = Platform_mapViewOfFile(m);
+	Platform_closeHandle(m);
+	if (*adr == 0) {
+		return Platform_err();
+	}
+	return 0;
+}
+
+INT16 Platform_UnmapFile (INT64 adr, INT32 l)
+{
+	if (Platform_unmapViewOfFile(adr) == 0) {
+		return Platform_err();
+	}
+	return 0;
+}
+
 INT16 Platform_Read (INT64 h, INT64 p, INT32 l, INT32 *n)
 {
 	INT16 result;
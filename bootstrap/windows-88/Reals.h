@@ -12,6 +12,10 @@ import void Reals_Convert (REAL x, INT16 n, CHAR *d, ADDRESS d__len);
 import void Reals_ConvertH (REAL y, CHAR *d, ADDRESS d__len);
 import void Reals_ConvertHL (LONGREAL x, CHAR *d, ADDRESS d__len);
 import void Reals_ConvertL (LONGREAL x, INT16 n, CHAR *d, ADDRESS d__len);
+import REAL Reals_Decimal (CHAR *d, ADDRESS d__len, INT16 n, INT32 e);
+import LONGREAL Reals_DecimalL (CHAR *d, ADDRESS d__len, INT16 n, INT32 e);
+import INT16 Reals_Digits (REAL x, INT16 p, CHAR *d, ADDRESS d__len, INT16 *e);
+import INT16 Reals_DigitsL (LONGREAL x, INT16 p, CHAR *d, ADDRESS d__len, INT16 *e);
 import INT16 Reals_Expo (REAL x);
 import INT16 Reals_ExpoL (LONGREAL x);
 import void Reals_SetExpo (REAL *x, INT16 ex);
@@ -7,7 +7,7 @@
 
 #include "SYSTEM.h"
 #include "Configuration.h"
-#include "Heap.h"
+#include "Files.h"
 #include "Modules.h"
 #include "OPM.h"
 #include "Out.h"
@@ -17,30 +17,38 @@
 typedef
 	CHAR extTools_CommandString[4096];
 
+typedef
+	struct extTools_Job {
+		INT64 pid;
+		CHAR title[32];
+		extTools_CommandString cmd;
+		Files_File state;
+	} extTools_Job;
+
 
 static extTools_CommandString extTools_CFLAGS;
+static extTools_Job extTools_jobs[9];
+static INT16 extTools_first, extTools_pending;
+export BOOLEAN extTools_useProfile;
 
+export ADDRESS *extTools_Job__typ;
 
-export void extTools_Assemble (CHAR *moduleName, ADDRESS moduleName__len);
+export void extTools_Assemble (CHAR *moduleName, ADDRESS moduleName__len, Files_File state);
 static void extTools_InitialiseCompilerCommand (CHAR *s, ADDRESS s__len);
 export void extTools_LinkMain (CHAR *moduleName, ADDRESS moduleName__len, BOOLEAN statically, CHAR *additionalopts, ADDRESS additionalopts__len);
+static void extTools_Report (CHAR *title, ADDRESS title__len, CHAR *cmd, ADDRESS cmd__len, INT16 r);
+export void extTools_Train (CHAR *moduleName, ADDRESS moduleName__len);
+export void extTools_WaitAll (void);
+static void extTools_WaitOldest (void);
 static void extTools_execute (CHAR *title, ADDRESS title__len, CHAR *cmd, ADDRESS cmd__len);
+static void extTools_spawn (CHAR *title, ADDRESS title__len, CHAR *cmd, ADDRESS cmd__len, Files_File state);
 
 
-static void extTools_execute (CHAR *title, ADDRESS title__len, CHAR *cmd, ADDRESS cmd__len)
+static void extTools_Report (CHAR *title, ADDRESS title__len, CHAR *cmd, ADDRESS cmd__len, INT16 r)
 {
-	INT16 r, status, exitcode;
-	extTools_CommandString fullcmd;
+	INT16 status, exitcode;
 	__DUP(title, title__len, CHAR);
 	__DUP(cmd, cmd__len, CHAR);
-	if (__IN(18, OPM_Options, 32)) {
-		Out_String((CHAR*)"  ", 3);
-		Out_String(cmd, cmd__len);
-		Out_Ln();
-	}
-	__COPY(cmd, fullcmd, 4096);
-	Heap_GC(0);
-	r = Platform_System(fullcmd, 4096);
 	status = __MASK(r, -128);
 	exitcode = __ASHR(r, 8);
 	if (exitcode > 127) {
@@ -60,6 +68,7 @@ static void extTools_execute (CHAR *title, ADDRESS title__len, CHAR *cmd, ADDRES
 			Out_String((CHAR*)"Is the C compiler in the current command path\?", 47);
 			Out_Ln();
 		}
+		Out_Flush();
 		if (status != 0) {
 			Modules_Halt(status);
 		} else {
@@ -70,9 +79,113 @@ static void extTools_execute (CHAR *title, ADDRESS title__len, CHAR *cmd, ADDRES
 	__DEL(cmd);
 }
 
+static void extTools_WaitOldest (void)
+{
+	INT16 r, res;
+	OPM_StartPhase(4);
+	res = Platform_Wait(extTools_jobs[__X(extTools_first, 9)].pid, &r);
+	OPM_StopPhase(4);
+	if (res != 0) {
+		r = 32512;
+	}
+	extTools_Report(extTools_jobs[__X(extTools_first, 9)].title, 32, extTools_jobs[__X(extTools_first, 9)].cmd, 4096, r);
+	if (extTools_jobs[__X(extTools_first, 9)].state != NIL) {
+		Files_Register(extTools_jobs[__X(extTools_first, 9)].state);
+		extTools_jobs[__X(extTools_first, 9)].state = NIL;
+	}
+	extTools_pending -= 1;
+	extTools_first += 1;
+	if (extTools_first >= 9) {
+		extTools_first = 0;
+	}
+}
+
+void extTools_WaitAll (void)
+{
+	while (extTools_pending > 0) {
+		extTools_WaitOldest();
+	}
+}
+
+static void extTools_spawn (CHAR *title, ADDRESS title__len, CHAR *cmd, ADDRESS cmd__len, Files_File state)
+{
+	INT16 i, res;
+	__DUP(title, title__len, CHAR);
+	__DUP(cmd, cmd__len, CHAR);
+	if (__IN(18, OPM_Options, 32)) {
+		Out_String((CHAR*)"  ", 3);
+		Out_String(cmd, cmd__len);
+		Out_Ln();
+	}
+	while (extTools_pending >= OPM_Jobs) {
+		extTools_WaitOldest();
+	}
+	i = extTools_first + extTools_pending;
+	if (i >= 9) {
+		i -= 9;
+	}
+	Out_Flush();
+	res = Platform_Spawn(cmd, cmd__len, &extTools_jobs[__X(i, 9)].pid);
+	if (res != 0) {
+		extTools_Report(title, title__len, cmd, cmd__len, 32512);
+	} else {
+		__COPY(title, extTools_jobs[__X(i, 9)].title, 32);
+		__COPY(cmd, extTools_jobs[__X(i, 9)].cmd, 4096);
+		extTools_jobs[__X(i, 9)].state = state;
+		extTools_pending += 1;
+	}
+	__DEL(title);
+	__DEL(cmd);
+}
+
+static void extTools_execute (CHAR *title, ADDRESS title__len, CHAR *cmd, ADDRESS cmd__len)
+{
+	INT16 r, res;
+	INT64 pid;
+	__DUP(title, title__len, CHAR);
+	__DUP(cmd, cmd__len, CHAR);
+	if (__IN(18, OPM_Options, 32)) {
+		Out_String((CHAR*)"  ", 3);
+		Out_String(cmd, cmd__len);
+		Out_Ln();
+	}
+	extTools_WaitAll();
+	OPM_StartPhase(4);
+	Out_Flush();
+	res = Platform_Spawn(cmd, cmd__len, &pid);
+	if (res == 0) {
+		res = Platform_Wait(pid, &r);
+	}
+	OPM_StopPhase(4);
+	if (res != 0) {
+		r = 32512;
+	}
+	extTools_Report(title, title__len, cmd, cmd__len, r);
+	__DEL(title);
+	__DEL(cmd);
+}
+
 static void extTools_InitialiseCompilerCommand (CHAR *s, ADDRESS s__len)
 {
-	__COPY("gcc -fPIC -g", s, s__len);
+	__COPY("gcc -fPIC", s, s__len);
+	switch (OPM_Profile) {
+		case 'r': 
+			Strings_Append((CHAR*)" -O2", 5, (void*)s, s__len);
+			break;
+		case 'l': 
+			Strings_Append((CHAR*)" -O2 -flto", 11, (void*)s, s__len);
+			break;
+		case 'p': 
+			if (extTools_useProfile) {
+				Strings_Append((CHAR*)" -O2 -fprofile-use -fprofile-correction", 40, (void*)s, s__len);
+			} else {
+				Strings_Append((CHAR*)" -O2 -fprofile-generate", 24, (void*)s, s__len);
+			}
+			break;
+		default: 
+			Strings_Append((CHAR*)" -g", 4, (void*)s, s__len);
+			break;
+	}
 	Strings_Append((CHAR*)" -I \"", 6, (void*)s, s__len);
 	Strings_Append(OPM_ResourceDir, 1024, (void*)s, s__len);
 	Strings_Append((CHAR*)"/include\" ", 11, (void*)s, s__len);
@@ -81,7 +194,7 @@ static void extTools_InitialiseCompilerCommand (CHAR *s, ADDRESS s__len)
 	Strings_Append((CHAR*)" ", 2, (void*)s, s__len);
 }
 
-void extTools_Assemble (CHAR *moduleName, ADDRESS moduleName__len)
+void extTools_Assemble (CHAR *moduleName, ADDRESS moduleName__len, Files_File state)
 {
 	extTools_CommandString cmd;
 	__DUP(moduleName, moduleName__len, CHAR);
@@ -89,7 +202,7 @@ void extTools_Assemble (CHAR *moduleName, ADDRESS moduleName__len)
 	Strings_Append((CHAR*)"-c ", 4, (void*)cmd, 4096);
 	Strings_Append(moduleName, moduleName__len, (void*)cmd, 4096);
 	Strings_Append((CHAR*)".c", 3, (void*)cmd, 4096);
-	extTools_execute((CHAR*)"C compile: ", 12, cmd, 4096);
+	extTools_spawn((CHAR*)"C compile: ", 12, cmd, 4096, state);
 	__DEL(moduleName);
 }
 
@@ -99,7 +212,14 @@ void extTools_LinkMain (CHAR *moduleName, ADDRESS moduleName__len, BOOLEAN stati
 	__DUP(additionalopts, additionalopts__len, CHAR);
 	extTools_InitialiseCompilerCommand((void*)cmd, 4096);
 	Strings_Append(moduleName, moduleName__len, (void*)cmd, 4096);
-	Strings_Append((CHAR*)".c ", 4, (void*)cmd, 4096);
+	if (__IN(20, OPM_Options, 32)) {
+		Strings_Append((CHAR*)".unity.c ", 10, (void*)cmd, 4096);
+		if (OPM_Profile == 'd') {
+			Strings_Append((CHAR*)"-O2 ", 5, (void*)cmd, 4096);
+		}
+	} else {
+		Strings_Append((CHAR*)".c ", 4, (void*)cmd, 4096);
+	}
 	Strings_Append(additionalopts, additionalopts__len, (void*)cmd, 4096);
 	if (statically) {
 		Strings_Append((CHAR*)" -static", 9, (void*)cmd, 4096);
@@ -110,7 +230,7 @@ void extTools_LinkMain (CHAR *moduleName, ADDRESS moduleName__len, BOOLEAN stati
 		Strings_Append((CHAR*)" -L\"", 5, (void*)cmd, 4096);
 		Strings_Append(OPM_InstallDir, 1024, (void*)cmd, 4096);
 		Strings_Append((CHAR*)"/lib\"", 6, (void*)cmd, 4096);
-		Strings_Append((CHAR*)" -lscream", 7, (void*)cmd, 4096);
+		Strings_Append((CHAR*)" -lscream", 10, (void*)cmd, 4096);
 		Strings_Append((CHAR*)"-O", 3, (void*)cmd, 4096);
 		Strings_Append(OPM_Model, 10, (void*)cmd, 4096);
 		Strings_Append((CHAR*)"", 1, (void*)cmd, 4096);
@@ -119,18 +239,42 @@ void extTools_LinkMain (CHAR *moduleName, ADDRESS moduleName__len, BOOLEAN stati
 	__DEL(additionalopts);
 }
 
+void extTools_Train (CHAR *moduleName, ADDRESS moduleName__len)
+{
+	extTools_CommandString cmd;
+	__DUP(moduleName, moduleName__len, CHAR);
+	Platform_GetEnv((CHAR*)"PGOTRAIN", 9, (void*)cmd, 4096);
+	if (cmd[0] == 0x00) {
+		__COPY("./", cmd, 4096);
+		Strings_Append(moduleName, moduleName__len, (void*)cmd, 4096);
+	}
+	extTools_execute((CHAR*)"Training run: ", 15, cmd, 4096);
+	__DEL(moduleName);
+}
+
+static void EnumPtrs(void (*P)(void*))
+{
+	__ENUMR(extTools_jobs, extTools_Job__typ, 4144, 9, P);
+}
+
+__TDESC(extTools_Job, 1, 1) = {__TDFLDS("Job", 4144), {4136, -16}};
 
 export void *extTools__init(void)
 {
 	__DEFMOD;
 	__MODULE_IMPORT(Configuration);
-	__MODULE_IMPORT(Heap);
+	__MODULE_IMPORT(Files);
 	__MODULE_IMPORT(Modules);
 	__MODULE_IMPORT(OPM);
 	__MODULE_IMPORT(Out);
 	__MODULE_IMPORT(Platform);
 	__MODULE_IMPORT(Strings);
-	__REGMOD("extTools", 0);
+	__REGMOD("extTools", EnumPtrs);
+	__REGCMD("WaitAll", extTools_WaitAll);
+	__INITYP(extTools_Job, extTools_Job, 0);
 /* BEGIN */
+	extTools_first = 0;
+	extTools_pending = 0;
+	extTools_useProfile = 0;
 	__ENDMOD;
 }